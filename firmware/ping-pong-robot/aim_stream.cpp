@@ -0,0 +1,116 @@
+#include "aim_stream.h"
+#include "config.h"
+#include "logic.h"
+#include "servos.h"
+
+struct AimSample {
+  uint16_t t;  // app ms, AIM_STREAM_T_MASK wide
+  q16_t pan;
+  q16_t tilt;
+};
+
+unsigned long aimStreamLate = 0;
+unsigned long aimStreamOverflows = 0;
+
+static AimSample ring[AIM_STREAM_SLOTS];
+static uint8_t ringHead = 0;   // oldest sample
+static uint8_t ringCount = 0;
+static bool streaming = false;
+static uint16_t playOffset = 0;  // local ms - app ms (mod T_MASK + 1) at playback
+static unsigned long lastSampleMs = 0;
+
+// Signed distance a - b between two masked timestamps
+static int16_t tDiff(uint16_t a, uint16_t b) {
+  return (int16_t)((uint16_t)((a - b) << 1)) >> 1;
+}
+
+static uint16_t playTime() {
+  return (uint16_t)(((uint16_t)millis() - playOffset) & AIM_STREAM_T_MASK);
+}
+
+static const AimSample& sampleAt(uint8_t i) {
+  return ring[(ringHead + i) & (AIM_STREAM_SLOTS - 1)];
+}
+
+static void ringPush(uint16_t t, q16_t pan, q16_t tilt) {
+  if (ringCount == AIM_STREAM_SLOTS) {
+    ringHead = (ringHead + 1) & (AIM_STREAM_SLOTS - 1);
+    ringCount--;
+    aimStreamOverflows++;
+  }
+  AimSample& s = ring[(ringHead + ringCount) & (AIM_STREAM_SLOTS - 1)];
+  s.t = t;
+  s.pan = pan;
+  s.tilt = tilt;
+  ringCount++;
+}
+
+// Restarts playback so that sample t plays AIM_STREAM_DELAY_MS from now, gliding there from the
+// current aim instead of jumping.
+static void anchor(uint16_t t) {
+  const uint16_t start = (uint16_t)((t - AIM_STREAM_DELAY_MS) & AIM_STREAM_T_MASK);
+  playOffset = (uint16_t)((uint16_t)millis() - start);
+  ringHead = 0;
+  ringCount = 0;
+  ringPush(start, isRunning ? livePan : cfg.panTarget, isRunning ? liveTilt : cfg.tiltTarget);
+}
+
+void aimStreamPush(uint16_t appMs, q16_t pan, q16_t tilt) {
+  const uint16_t t = appMs & AIM_STREAM_T_MASK;
+  if (!streaming) {
+    streaming = true;
+    anchor(t);
+  } else {
+    const AimSample& last = sampleAt(ringCount - 1);
+    if (tDiff(t, last.t) <= 0) return;  // duplicate or out of order
+    if (tDiff(t, playTime()) <= 0) {
+      aimStreamLate++;
+      anchor(t);
+    }
+  }
+  ringPush(t, pan, tilt);
+  lastSampleMs = millis();
+}
+
+void aimStreamStop() {
+  streaming = false;
+}
+
+bool aimStreamActive() {
+  return streaming;
+}
+
+void aimStreamTick() {
+  if (!streaming) return;
+  if (millis() - lastSampleMs > AIM_STREAM_TIMEOUT_MS) {
+    streaming = false;
+    return;
+  }
+
+  const uint16_t now = playTime();
+  while (ringCount >= 2 && tDiff(now, sampleAt(1).t) >= 0) {
+    ringHead = (ringHead + 1) & (AIM_STREAM_SLOTS - 1);
+    ringCount--;
+  }
+
+  const AimSample& a = sampleAt(0);
+  q16_t pan = a.pan;
+  q16_t tilt = a.tilt;
+  int16_t k = tDiff(now, a.t);
+  if (ringCount >= 2 && k > 0) {
+    const AimSample& b = sampleAt(1);
+    int16_t span = tDiff(b.t, a.t);
+    // |b - a| <= 2.0 (2^17) and k < span <= 1000, so the product fits in int32. Wider gaps (app
+    // paused between samples) step instead of sweeping.
+    if (span <= 1000) {
+      pan += (b.pan - a.pan) * (int32_t)k / span;
+      tilt += (b.tilt - a.tilt) * (int32_t)k / span;
+    }
+  }
+
+  cfg.panTarget = pan;
+  cfg.tiltTarget = tilt;
+  livePan = pan;
+  liveTilt = tilt;
+  if (!isRunning) updateServos(pan, tilt);  // running: updateRunningLogic() writes the servos
+}
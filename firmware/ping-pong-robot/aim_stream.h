@@ -0,0 +1,24 @@
+#ifndef AIM_STREAM_H
+#define AIM_STREAM_H
+
+#include <Arduino.h>
+#include "fixedpoint.h"
+
+// Streamed live aim: the app sends timestamped samples (A,pan,tilt,t / 6-byte aim frame) at
+// 30-50 Hz. They are buffered and played back AIM_STREAM_DELAY_MS behind the app clock, linearly
+// interpolated on every control tick, so BLE packets that arrive in bunches still give smooth motion.
+
+#define AIM_STREAM_SLOTS      8     // power of two
+#define AIM_STREAM_DELAY_MS   60    // playback lag; covers 2-3 samples of connection-interval jitter
+#define AIM_STREAM_TIMEOUT_MS 300   // no sample for this long: stream ends, aim stays where it is
+#define AIM_STREAM_T_MASK     0x7FFF  // app timestamps are ms mod 32768 (fits a text field)
+
+extern unsigned long aimStreamLate;       // samples that arrived after their playback time
+extern unsigned long aimStreamOverflows;  // samples dropped because the buffer was full
+
+void aimStreamPush(uint16_t appMs, q16_t pan, q16_t tilt);
+void aimStreamStop();  // an immediate aim (no timestamp) overrides the stream
+bool aimStreamActive();
+void aimStreamTick();  // control tick: moves the aim target to the interpolated sample
+
+#endif
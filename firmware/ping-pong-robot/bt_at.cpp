@@ -0,0 +1,199 @@
+#include "bt_at.h"
+#include "bt_command.h"
+#include "tx_queue.h"
+#include <EEPROM.h>
+#include <avr/pgmspace.h>
+
+// Servo limits use EEPROM 0..6, the servo calibration 10..36
+#define EEPROM_BT_BAUD       8  // index into BT_RATES of the rate the module last answered at
+#define EEPROM_BT_BAUD_CHECK 9  // index ^ 0xFF
+
+// Index = HM-10 AT+BAUD<n> code
+static const uint32_t BT_RATES[] PROGMEM = { 9600UL, 19200UL, 38400UL, 57600UL, 115200UL };
+#define BT_RATE_COUNT 5
+
+#define BT_AT_WAKE_BYTES 80  // a sleeping HM-10 wakes on a string this long
+
+enum BtAtState : uint8_t {
+  AT_BOOT,      // module powering up
+  AT_WAKE,      // wake string going out
+  AT_PROBE,     // "AT" sent at the candidate rate
+  AT_SET_BAUD,  // AT+BAUD<n> sent
+  AT_SET_NAME,  // AT+NAME sent
+  AT_RESTART,   // AT+RESET sent; module reboots at its configured rate
+  AT_VERIFY,    // "AT" sent at the new rate
+  AT_READY
+};
+
+static BtAtState atState = AT_READY;
+static unsigned long atSinceMs = 0;
+static uint8_t atRate = 0;       // Serial1 is open at BT_RATES[atRate]
+static uint8_t atSavedRate = 0;
+static uint8_t atFoundRate = 0;  // rate the module answered at before AT+BAUD
+static uint8_t atProbes = 0;
+static uint8_t atWakeLeft = 0;
+static bool atOk = false;        // "OK" seen since the last command (replies have no terminator)
+static char atPrev = 0;
+
+static uint32_t rateAt(uint8_t i) {
+  return pgm_read_dword(&BT_RATES[i]);
+}
+
+static uint8_t rateIndex(uint32_t baud) {
+  for (uint8_t i = 0; i < BT_RATE_COUNT; i++) {
+    if (rateAt(i) == baud) return i;
+  }
+  return 0;
+}
+
+static uint8_t loadSavedRate() {
+  uint8_t i = EEPROM.read(EEPROM_BT_BAUD);
+  if (i < BT_RATE_COUNT && EEPROM.read(EEPROM_BT_BAUD_CHECK) == (uint8_t)(i ^ 0xFF)) return i;
+  return rateIndex(BT_BAUD);
+}
+
+static void saveRate(uint8_t i) {
+  if (i == atSavedRate) return;  // cells are only written when the rate changes
+  EEPROM.write(EEPROM_BT_BAUD, i);
+  EEPROM.write(EEPROM_BT_BAUD_CHECK, (uint8_t)(i ^ 0xFF));
+  atSavedRate = i;
+}
+
+static void atOpen(uint8_t i) {
+  atRate = i;
+  BT_SERIAL.begin(rateAt(i));
+}
+
+// AT commands have no terminator; each goes out as one TX_REPLY message
+static void atSend(const __FlashStringHelper* cmd) {
+  TxLine(TX_REPLY).print(cmd);
+}
+
+static void atExpect(BtAtState next) {
+  atState = next;
+  atOk = false;
+  atPrev = 0;
+  atSinceMs = millis();
+}
+
+static void atFinish(uint8_t i) {
+  if (atRate != i) atOpen(i);
+  saveRate(i);
+  atState = AT_READY;
+  TxLine dbg(TX_LOG);
+  dbg.print(F("[BT] HM-10 at "));
+  dbg.print(rateAt(i));
+  dbg.print('\n');
+}
+
+static void atSendName() {
+  atSend(F("AT+NAME" BT_AT_NAME));
+  atExpect(AT_SET_NAME);
+}
+
+void btAtBegin() {
+  atSavedRate = loadSavedRate();
+  atOpen(atSavedRate);
+#if BT_AT_INIT_AT_STARTUP
+  atExpect(AT_BOOT);
+#else
+  atState = AT_READY;
+#endif
+}
+
+bool btAtReady() {
+  return atState == AT_READY;
+}
+
+unsigned long btAtBaud() {
+  return rateAt(atRate);
+}
+
+void btAtPoll() {
+  if (atState == AT_READY) return;
+
+  while (BT_SERIAL.available()) {
+    char c = (char)BT_SERIAL.read();
+    if (atPrev == 'O' && c == 'K') atOk = true;
+    atPrev = c;
+  }
+
+  const uint8_t fast = rateIndex(BT_BAUD_FAST);
+  const unsigned long elapsed = millis() - atSinceMs;
+  switch (atState) {
+    case AT_BOOT:
+      if (elapsed >= BT_AT_BOOT_MS) {
+        atWakeLeft = BT_AT_WAKE_BYTES;
+        atExpect(AT_WAKE);
+      }
+      break;
+
+    case AT_WAKE:
+      // Only what fits in the TX queue, so the loop never waits on the UART
+      if (atWakeLeft > 0) {
+        while (atWakeLeft > 0 && txRoom(TX_REPLY) >= 8) {
+          atSend(F("xxxxxxxx"));
+          atWakeLeft -= 8;
+        }
+        if (atWakeLeft == 0) atExpect(AT_WAKE);
+      } else if (elapsed >= 100) {
+        atProbes = 0;
+        atSend(F("AT"));
+        atExpect(AT_PROBE);
+      }
+      break;
+
+    case AT_PROBE:
+      if (atOk) {
+        atFoundRate = atRate;
+        if (atRate == fast) {
+          atSendName();
+        } else {
+          TxLine out(TX_REPLY);
+          out.print(F("AT+BAUD"));
+          out.print(fast);
+          atExpect(AT_SET_BAUD);
+        }
+      } else if (elapsed >= BT_AT_REPLY_MS) {
+        if (++atProbes >= BT_RATE_COUNT) {
+          // No answer at any rate (e.g. a phone is already linked): keep the saved rate
+          atFinish(atSavedRate);
+        } else {
+          atOpen((uint8_t)((atRate + 1) % BT_RATE_COUNT));
+          atSend(F("AT"));
+          atExpect(AT_PROBE);
+        }
+      }
+      break;
+
+    case AT_SET_BAUD:
+      if (atOk || elapsed >= BT_AT_REPLY_MS) atSendName();
+      break;
+
+    case AT_SET_NAME:
+      if (atOk || elapsed >= BT_AT_REPLY_MS) {
+        atSend(F("AT+RESET"));
+        atExpect(AT_RESTART);
+      }
+      break;
+
+    case AT_RESTART:
+      if (elapsed >= BT_AT_RESTART_MS) {
+        atOpen(fast);
+        atSend(F("AT"));
+        atExpect(AT_VERIFY);
+      }
+      break;
+
+    case AT_VERIFY:
+      if (atOk) {
+        atFinish(atRate);
+      } else if (elapsed >= BT_AT_REPLY_MS) {
+        atFinish(atFoundRate);  // AT+BAUD did not take; the module is still at the old rate
+      }
+      break;
+
+    default:
+      break;
+  }
+}
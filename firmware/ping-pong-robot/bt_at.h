@@ -0,0 +1,23 @@
+#ifndef BT_AT_H
+#define BT_AT_H
+
+#include <Arduino.h>
+
+// HM-10 startup handshake as a non-blocking state machine, polled from processBTInput(). The
+// module is probed with "AT" at the rate saved in EEPROM first and then at every other rate, moved
+// to BT_BAUD_FAST with AT+BAUD, renamed and reset. The rate that answers afterwards is saved so the
+// next boot usually needs a single probe. Until btAtReady(), bytes from Serial1 are AT replies and
+// are not parsed as app commands.
+
+#define BT_BAUD_FAST       57600UL  // 0.8% UART error at 16 MHz (115200 is 2.1%)
+#define BT_AT_NAME         "SpinRobot"
+#define BT_AT_BOOT_MS      500UL    // module power-up before the first byte
+#define BT_AT_REPLY_MS     300UL    // wait for OK / OK+Set
+#define BT_AT_RESTART_MS   1000UL   // AT+RESET until the module answers at its new rate
+
+void btAtBegin();       // opens Serial1 at the saved rate and starts the handshake
+void btAtPoll();        // advances the handshake; consumes Serial1 bytes while not ready
+bool btAtReady();
+unsigned long btAtBaud();  // rate Serial1 is currently open at
+
+#endif
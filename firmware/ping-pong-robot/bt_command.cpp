@@ -1,14 +1,20 @@
 #include "bt_command.h"
+#include "ram.h"
+#include "bt_frame.h"
+#include "bt_at.h"
+#include "aim_stream.h"
+#include "telemetry.h"
+#include "drill.h"
 #include "config.h"
 #include "logic.h"
 #include "motors.h"
 #include "servos.h"
+#include "profiler.h"
+#include "profiles.h"
+#include "tx_queue.h"
 #include <Arduino.h>
 #include <string.h>
 
-static char lineBuf[BT_LINE_BUF_SIZE];
-static int lineLen = 0;
-
 volatile bool btConnected = false;
 char btDeviceName[BT_DEVICE_NAME_LEN + 1] = { '\0' };
 static unsigned long stateHighSinceMs = 0;
@@ -31,7 +37,8 @@ static void setBTDisconnected(void) {
     btDeviceName[0] = '\0';
     stateHighSinceMs = 0;
     stateNotConnectedSinceMs = 0;
-    Serial.println(F("[BT] DISCONNECTED"));
+    setTelemetryEnabled(false);
+    TxLine(TX_LOG).print(F("[BT] DISCONNECTED\n"));
   }
 }
 
@@ -72,9 +79,9 @@ void updateBTState() {
   }
 }
 
-static void clampFloat(float &v, float lo, float hi) {
-  if (v < lo) v = lo;
-  if (v > hi) v = hi;
+// value*1000 from the app -> Q16, clamped
+static q16_t milliToQ16(int milli, q16_t lo, q16_t hi) {
+  return q16Clamp(q16FromMilli(milli), lo, hi);
 }
 
 static void clampInt(int &v, int lo, int hi) {
@@ -103,219 +110,685 @@ static SpinMode intToSpinMode(int v) {
   return (SpinMode)v;
 }
 
-static void logLineReceived(void) {
-  Serial.print(F("[BT RX] "));
-  for (int i = 0; i < lineLen; i++) {
-    char c = lineBuf[i];
-    Serial.print((c >= 32 && c < 127) ? c : '.');
+// ================= App actions =================
+// Shared by the text parser below and binary frames (bt_frame.cpp).
+
+void startFromApp() {
+  startRunning(true);
+  TxLine(TX_REPLY).print(F("OK,S\n"));
+}
+
+void stopFromApp() {
+  if (isRunning) {
+    isRunning = false;
+    stopAllMotors();
   }
-  Serial.println();
+  currentScreen = SCREEN_HOME;
 }
 
-// Processa uma linha: S/START = start, P/STOP = stop, N,name = device name, C,... = config
-static void processLine() {
-  if (lineLen <= 0) return;
+// Aplica A,<pan*1000>,<tilt*1000>: alvo LIVE e servos imediatamente
+void applyAimMilli(int p1000, int t1000) {
+  aimStreamStop();
+  cfg.panTarget = milliToQ16(p1000, -Q16_ONE, Q16_ONE);
+  cfg.tiltTarget = milliToQ16(t1000, -Q16_ONE, Q16_ONE);
+  livePan = cfg.panTarget;
+  liveTilt = cfg.tiltTarget;
+  updateServos(cfg.panTarget, cfg.tiltTarget);
+}
 
-  lineBuf[lineLen] = '\0';
-  logLineReceived();
+// A,<pan*1000>,<tilt*1000>,<t>: sample for the jitter buffer, played back on the control tick
+void applyAimSampleMilli(int p1000, int t1000, uint16_t appMs) {
+  aimStreamPush(appMs, milliToQ16(p1000, -Q16_ONE, Q16_ONE), milliToQ16(t1000, -Q16_ONE, Q16_ONE));
+}
 
-  if (lineBuf[0] == 'S') {
-    if (lineLen == 1 || (lineLen >= 5 && strncmp(lineBuf, "START", 5) == 0)) {
-      startRunning();
-      BT_SERIAL.print(F("OK,S\n"));
-    }
-    lineLen = 0;
+uint16_t configRevision = 0;
+static uint16_t configRevisionCrc = 0;  // CRC of packConfig() as of configRevision
+static bool deltaTouchedAim = false;
+
+static uint16_t configCrc() {
+  uint8_t packed[CONFIG_PACKED_LEN];
+  packConfig(packed);
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < CONFIG_PACKED_LEN; i++) crc = crc16Ccitt(crc, packed[i]);
+  return crc;
+}
+
+static void bumpConfigRevision() {
+  configRevision++;
+  configRevisionCrc = configCrc();
+}
+
+void configRevisionPoll() {
+  if (configCrc() != configRevisionCrc) bumpConfigRevision();
+}
+
+// One config field by its index in <C,...> order (same clamps for full and delta updates)
+void applyConfigField(uint8_t id, int v) {
+  switch (id) {
+    case 0:  cfg.panMode = intToAxisMode(v); break;
+    case 1:  cfg.tiltMode = intToAxisMode(v); break;
+    case 2:  cfg.panTarget = milliToQ16(v, -Q16_ONE, Q16_ONE); deltaTouchedAim = true; break;
+    case 3:  cfg.tiltTarget = milliToQ16(v, -Q16_ONE, Q16_ONE); deltaTouchedAim = true; break;
+    case 4:  cfg.panMin = milliToQ16(v, -Q16_ONE, Q16_ONE); break;
+    case 5:  cfg.panMax = milliToQ16(v, -Q16_ONE, Q16_ONE); break;
+    case 6:  cfg.tiltMin = milliToQ16(v, -Q16_ONE, Q16_ONE); break;
+    case 7:  cfg.tiltMax = milliToQ16(v, -Q16_ONE, Q16_ONE); break;
+
+    case 8:  cfg.panAuto1Speed = milliToQ16(v, Q16(0.005), Q16(0.08)); break;
+    case 9:  cfg.panAuto2Step = milliToQ16(v, Q16(0.05), Q16(0.5)); break;
+    case 10: cfg.panAuto2PauseMs = (unsigned long)v; clampUL(cfg.panAuto2PauseMs, 100UL, 10000UL); break;
+    case 11: cfg.tiltAuto1Speed = milliToQ16(v, Q16(0.005), Q16(0.08)); break;
+    case 12: cfg.tiltAuto2Step = milliToQ16(v, Q16(0.05), Q16(0.5)); break;
+    case 13: cfg.tiltAuto2PauseMs = (unsigned long)v; clampUL(cfg.tiltAuto2PauseMs, 100UL, 10000UL); break;
+
+    case 14: cfg.panRandomMinDist = milliToQ16(v, Q16(0.1), Q16(0.5)); break;
+    case 15: cfg.panRandomPauseMs = (unsigned long)v; clampUL(cfg.panRandomPauseMs, 500UL, 30000UL); break;
+    case 16: cfg.tiltRandomMinDist = milliToQ16(v, Q16(0.1), Q16(0.5)); break;
+    case 17: cfg.tiltRandomPauseMs = (unsigned long)v; clampUL(cfg.tiltRandomPauseMs, 500UL, 30000UL); break;
+
+    case 18: cfg.launcherPower = v; clampInt(cfg.launcherPower, 0, 255); break;
+    case 19: cfg.spinMode = intToSpinMode(v); break;
+    case 20: cfg.spinIntensity = v; clampInt(cfg.spinIntensity, 0, 512); break;
+    case 21: cfg.feederMode = intToFeederMode(v); break;
+    case 22: cfg.feederSpeed = v; clampInt(cfg.feederSpeed, 0, 255); break;
+    case 23: cfg.feederCustomOnMs = (unsigned long)v; clampUL(cfg.feederCustomOnMs, 100UL, 10000UL); break;
+    case 24: cfg.feederCustomOffMs = (unsigned long)v; clampUL(cfg.feederCustomOffMs, 100UL, 10000UL); break;
+    case 25: cfg.timerIndex = v; clampInt(cfg.timerIndex, 0, 5); break;
+    case 26: cfg.feederBpm = v; clampInt(cfg.feederBpm, 10, 120); break;
+    case 27: cfg.ballLimit = v; clampInt(cfg.ballLimit, 0, 999); break;
+    default: break;
+  }
+}
+
+int configFieldValue(uint8_t id) {
+  switch (id) {
+    case 0:  return cfg.panMode;
+    case 1:  return cfg.tiltMode;
+    case 2:  return (int)q16ToMilli(cfg.panTarget);
+    case 3:  return (int)q16ToMilli(cfg.tiltTarget);
+    case 4:  return (int)q16ToMilli(cfg.panMin);
+    case 5:  return (int)q16ToMilli(cfg.panMax);
+    case 6:  return (int)q16ToMilli(cfg.tiltMin);
+    case 7:  return (int)q16ToMilli(cfg.tiltMax);
+
+    case 8:  return (int)q16ToMilli(cfg.panAuto1Speed);
+    case 9:  return (int)q16ToMilli(cfg.panAuto2Step);
+    case 10: return (int)cfg.panAuto2PauseMs;
+    case 11: return (int)q16ToMilli(cfg.tiltAuto1Speed);
+    case 12: return (int)q16ToMilli(cfg.tiltAuto2Step);
+    case 13: return (int)cfg.tiltAuto2PauseMs;
+
+    case 14: return (int)q16ToMilli(cfg.panRandomMinDist);
+    case 15: return (int)cfg.panRandomPauseMs;
+    case 16: return (int)q16ToMilli(cfg.tiltRandomMinDist);
+    case 17: return (int)cfg.tiltRandomPauseMs;
+
+    case 18: return cfg.launcherPower;
+    case 19: return cfg.spinMode;
+    case 20: return cfg.spinIntensity;
+    case 21: return cfg.feederMode;
+    case 22: return cfg.feederSpeed;
+    case 23: return (int)cfg.feederCustomOnMs;
+    case 24: return (int)cfg.feederCustomOffMs;
+    case 25: return cfg.timerIndex;
+    case 26: return cfg.feederBpm;
+    case 27: return cfg.ballLimit;
+    default: return 0;
+  }
+}
+
+// First n fields in <C,...> order, then the same follow-up as any full config
+static void setConfigFields(const int* v, uint8_t n) {
+  if (n > BT_CONFIG_FIELDS) n = BT_CONFIG_FIELDS;
+  configRevisionPoll();  // a change made on the robot since the last revision gets its own
+  for (uint8_t i = 0; i < n; i++) applyConfigField(i, v[i]);
+  deltaTouchedAim = false;
+  bumpConfigRevision();
+
+  if (!isRunning) {
+    updateServos(cfg.panTarget, cfg.tiltTarget);
+  }
+}
+
+void applyStoredConfig(const int* v) {
+  setConfigFields(v, BT_CONFIG_FIELDS);
+}
+
+// CONFIG: 26 or 28 ints (order same as app): panMode, tiltMode, panTarget*1000, ...
+void applyConfigFields(const int* v, uint8_t n) {
+  // Each drill step rebuilds cfg from the base it saved at start, so a write now would be lost
+  if (drillCurrentStep() != 0) {
+    TxLine(TX_REPLY).print(F("ERR,C,BUSY\n"));
     return;
   }
-  if (lineBuf[0] == 'P') {
-    if (lineLen == 1 || (lineLen >= 4 && strncmp(lineBuf, "STOP", 4) == 0)) {
-      if (isRunning) {
-        isRunning = false;
-        stopAllMotors();
-      }
-      currentScreen = SCREEN_HOME;
-    }
-    lineLen = 0;
+  setConfigFields(v, n);
+  TxLine out(TX_REPLY);
+  out.print(F("OK,C,"));
+  out.print(configRevision);
+  out.print('\n');
+}
+
+bool beginConfigDelta() {
+  if (drillCurrentStep() != 0) {
+    TxLine(TX_REPLY).print(F("ERR,U,BUSY\n"));
+    return false;
+  }
+  configRevisionPoll();
+  deltaTouchedAim = false;
+  return true;
+}
+
+// Ends a delta update (one or more applyConfigField calls): only touched members changed
+void finishConfigDelta() {
+  bumpConfigRevision();
+  if (deltaTouchedAim && !isRunning) {
+    updateServos(cfg.panTarget, cfg.tiltTarget);
+  }
+  deltaTouchedAim = false;
+  TxLine out(TX_REPLY);
+  out.print(F("OK,U,"));
+  out.print(configRevision);
+  out.print('\n');
+}
+
+// Stores one drill step (drill.h); replies OK,Q,<steps stored>
+void drillStepFromApp(uint8_t step, DrillEnd end, uint16_t amount, const uint8_t* ids, const int* values, uint8_t n) {
+  if (drillCurrentStep() != 0) {
+    TxLine(TX_REPLY).print(F("ERR,Q,BUSY\n"));
+    return;
+  }
+  if (!drillSetStep(step, end, amount, ids, values, n)) {
+    TxLine(TX_REPLY).print(F("ERR,Q,INVALID\n"));
+    return;
+  }
+  TxLine out(TX_REPLY);
+  out.print(F("OK,Q,"));
+  out.print(drillStepCount());
+  out.print('\n');
+}
+
+void drillClearFromApp() {
+  if (!drillClear()) {
+    TxLine(TX_REPLY).print(F("ERR,Q,BUSY\n"));
     return;
   }
-  if (lineBuf[0] == 'D' && (lineLen == 1 || (lineLen >= 8 && strncmp(lineBuf, "DISCONNECT", 8) == 0))) {
-    setBTDisconnected();
-    lineLen = 0;
+  TxLine(TX_REPLY).print(F("OK,Q,0\n"));
+}
+
+// ================= RX parser =================
+// Byte-at-a-time state machine. Fields are decoded as they arrive (no line buffer, no second
+// pass) and a config block is applied the moment its closing '>' arrives. Line protocol:
+//   S / START, P, D / DISCONNECT, T / T,S / T,R   short words, run at end of line
+//   V                                              protocol query -> OK,V,<BT_FRAME_VERSION>
+//   M / M,S                                        RAM budget (ram.h) to the app / to Serial
+//   A,<pan*1000>,<tilt*1000>                       live aim, applied at end of line
+//   A,<pan*1000>,<tilt*1000>,<app ms & 0x7FFF>     streamed live aim sample (aim_stream.h)
+//   N,<name>                                       anywhere in a line (app device name)
+//   <C,v0,...,v27>                                 config (26 fields from older apps); the last "<C," in a line wins
+//   U,<id>,<value>[,<id>,<value>...]               delta config (ids = <C,...> index), up to 14 pairs
+//   Q,<step>,<end>,<amount>[,<id>,<value>...]      drill step (drill.h), up to 8 fields; Q,0 clears
+//   W,<slot>[,<name>] / L,<slot> / L                save cfg to / load / list profiles (profiles.h)
+//   K,<servo>[,<c0>,...,<c12>]                     servo pulse calibration (servos.h): read / set
+// A BT_FRAME_SYNC byte (never valid in text) hands the following bytes to bt_frame.cpp.
+enum BtRxState : uint8_t {
+  RX_LINE_START,  // next byte is the first of a line
+  RX_WORD,        // short command word (S/P/D/T/V/W/L/M lines)
+  RX_SCAN,        // other lines: look for "A," / "U," / "Q," / "K," (at start), "N," or "<C,"
+  RX_NAME,        // after "N,"
+  RX_FIELDS,      // after "A,", "U,", "Q,", "K," or "<C,": comma-separated ints
+  RX_SKIP         // rest of the line is ignored
+};
+
+#define BT_WORD_MAX (4 + PROFILE_NAME_LEN + 1)  // "W,<slot>,<name>" + '\0'; longer words are truncated
+
+static BtRxState rxState = RX_LINE_START;
+static uint8_t rxLinePos = 0;     // bytes seen in this line (saturates)
+static char rxPrev = 0;           // previous byte of the line
+static uint8_t rxConfigMatch = 0; // progress through "<C,"
+
+static char rxWord[BT_WORD_MAX];
+static uint8_t rxWordLen = 0;
+static uint8_t rxNameLen = 0;
+
+// Field decoder: same result as atoi() on each comma-separated field
+enum BtRxFields : uint8_t { RX_FIELDS_AIM, RX_FIELDS_CONFIG, RX_FIELDS_DELTA, RX_FIELDS_DRILL, RX_FIELDS_CAL };
+static BtRxFields rxFieldsKind = RX_FIELDS_AIM;
+static int rxFields[BT_CONFIG_FIELDS];
+static uint8_t rxFieldCount = 0;
+static int32_t rxAcc = 0;
+static bool rxNeg = false;
+static bool rxDigits = false;      // sign or digit seen in the current field
+static bool rxFieldEnded = false;  // atoi() would have stopped here
+static bool rxFieldAny = false;    // any byte since the last comma
+
+#if BT_LOG_RX
+static bool rxLogLineStart = true;
+static TxLine rxLog(TX_LOG);  // one queued (or dropped) message per received line
+
+static void logRxByte(char c) {
+  if (c == '\n' || c == '\r') {
+    if (!rxLogLineStart) rxLog.print('\n');
+    rxLogLineStart = true;
     return;
   }
-  const char* nCmd = strstr(lineBuf, "N,");
-  if (nCmd != nullptr) {
-    int i = 0;
-    const char* src = nCmd + 2;
-    while (*src && *src != '\r' && *src != '\n' && *src != ',' && i < BT_DEVICE_NAME_LEN) {
-      btDeviceName[i++] = *src++;
+  if (rxLogLineStart) {
+    rxLog.print(F("[BT RX] "));
+    rxLogLineStart = false;
+  }
+  rxLog.print((c >= 32 && c < 127) ? c : '.');
+}
+#endif
+
+static void rxFieldReset() {
+  rxAcc = 0;
+  rxNeg = false;
+  rxDigits = false;
+  rxFieldEnded = false;
+  rxFieldAny = false;
+}
+
+static void rxBeginFields(BtRxFields kind) {
+  rxFieldsKind = kind;
+  rxFieldCount = 0;
+  rxFieldReset();
+  rxState = RX_FIELDS;
+}
+
+static void rxPushField() {
+  if (rxFieldCount < BT_CONFIG_FIELDS) {
+    rxFields[rxFieldCount] = (int)(rxNeg ? -rxAcc : rxAcc);
+  }
+  if (rxFieldCount < 255) rxFieldCount++;
+  rxFieldReset();
+}
+
+static void rxFieldByte(char c) {
+  rxFieldAny = true;
+  if (rxFieldEnded) return;
+  if (c >= '0' && c <= '9') {
+    rxDigits = true;
+    rxAcc = rxAcc * 10 + (c - '0');
+    if (rxAcc > 32767) rxAcc = 32767;  // int is 16-bit on the Mega; saturate the same on host
+  } else if ((c == '-' || c == '+') && !rxDigits) {
+    rxNeg = (c == '-');
+    rxDigits = true;
+  } else if ((c == ' ' || c == '\t') && !rxDigits) {
+    // atoi() skips leading whitespace
+  } else {
+    rxFieldEnded = true;
+  }
+}
+
+static void rxFinishConfig() {
+  if (rxFieldAny) rxPushField();
+  // 26 (older apps) or 28; fields past the last one are ignored as before. 27 is a truncated line.
+  if (rxFieldCount == BT_CONFIG_FIELDS_MIN || rxFieldCount >= BT_CONFIG_FIELDS) {
+    applyConfigFields(rxFields, rxFieldCount);
+  } else {
+    TxLine(TX_LOG).print(F("[BT] Config rejected: invalid (expected 26 or 28 fields)\n"));
+    TxLine(TX_REPLY).print(F("ERR,C,INVALID\n"));
+  }
+}
+
+// U,<id>,<value>,...: validated as a whole, then only the listed fields are applied
+static void rxFinishDelta() {
+  if (rxFieldCount == 0 || (rxFieldCount & 1) || rxFieldCount > BT_CONFIG_FIELDS) {
+    TxLine(TX_REPLY).print(F("ERR,U,INVALID\n"));
+    return;
+  }
+  for (uint8_t i = 0; i < rxFieldCount; i += 2) {
+    if (rxFields[i] < 0 || rxFields[i] >= BT_CONFIG_FIELDS) {
+      TxLine(TX_REPLY).print(F("ERR,U,FIELD\n"));
+      return;
     }
-    btDeviceName[i] = '\0';
-    btConnected = true;
-    stateHighSinceMs = 0;
-    stateNotConnectedSinceMs = 0;
-    Serial.print(F("[BT] CONNECTED name="));
-    Serial.println(btDeviceName[0] ? btDeviceName : "(none)");
   }
-  if (nCmd != nullptr && lineBuf[0] != 'S' && lineBuf[0] != 'P' && lineBuf[0] != 'C' && lineBuf[0] != 'A') {
-    lineLen = 0;
+  if (!beginConfigDelta()) return;
+  for (uint8_t i = 0; i < rxFieldCount; i += 2) applyConfigField((uint8_t)rxFields[i], rxFields[i + 1]);
+  finishConfigDelta();
+}
+
+static void rxFinishDrill() {
+  if (rxFieldCount == 1 && rxFields[0] == 0) {
+    drillClearFromApp();
     return;
   }
-  if (lineBuf[0] == 'A' && lineBuf[1] == ',') {
-    int p1000 = 0, t1000 = 0;
-    char* q = lineBuf + 2;
-    if (*q) { p1000 = atoi(q); while (*q && *q != ',') q++; if (*q == ',') q++; }
-    if (*q) t1000 = atoi(q);
-    cfg.panTarget = (float)p1000 / 1000.0f;
-    cfg.tiltTarget = (float)t1000 / 1000.0f;
-    clampFloat(cfg.panTarget, -1.0f, 1.0f);
-    clampFloat(cfg.tiltTarget, -1.0f, 1.0f);
-    livePan = cfg.panTarget;
-    liveTilt = cfg.tiltTarget;
-    updateServos(cfg.panTarget, cfg.tiltTarget);
-    lineLen = 0;
+  if (rxFieldCount < 3 || ((rxFieldCount - 3) & 1) || rxFieldCount > 3 + 2 * DRILL_MAX_FIELDS ||
+      rxFields[0] < 1 || rxFields[0] > DRILL_MAX_STEPS || rxFields[1] < 0 || rxFields[1] >= DRILL_END_COUNT ||
+      rxFields[2] < 0) {
+    TxLine(TX_REPLY).print(F("ERR,Q,INVALID\n"));
     return;
   }
-  // CONFIG: framed as <C,v0,v1,...,v25> so we only run when a complete block (start+end) is received.
-  const char* configStartMarker = "<C,";
-  const size_t configStartLen = 3;
-  char* lastBlock = (char*)lineBuf;
-  for (char* q = lineBuf; *q; q++) {
-    if (q[0] == '<' && q[1] == 'C' && q[2] == ',') lastBlock = q + configStartLen;
-  }
-  bool hasConfigMarker = (strstr(lineBuf, configStartMarker) != nullptr);
-  bool endsWithClose = (lineLen >= 1 && lineBuf[lineLen - 1] == '>');
-
-  if (hasConfigMarker) {
-    if (!endsWithClose) {
-      Serial.println(F("[BT] Config rejected: incomplete (block does not end with '>')"));
-      BT_SERIAL.print(F("ERR,C,INCOMPLETE\n"));
-      lineLen = 0;
+  uint8_t ids[DRILL_MAX_FIELDS];
+  int values[DRILL_MAX_FIELDS];
+  const uint8_t n = (uint8_t)((rxFieldCount - 3) / 2);
+  for (uint8_t i = 0; i < n; i++) {
+    const int id = rxFields[3 + 2 * i];
+    if (id < 0 || id >= BT_CONFIG_FIELDS) {
+      TxLine(TX_REPLY).print(F("ERR,Q,FIELD\n"));
       return;
     }
-    char* endBlock = (char*)(lineBuf + lineLen - 1);
-    if (lastBlock > endBlock) {
-      Serial.println(F("[BT] Config rejected: invalid (no content between markers)"));
-      BT_SERIAL.print(F("ERR,C,INVALID\n"));
-      lineLen = 0;
+    ids[i] = (uint8_t)id;
+    values[i] = rxFields[4 + 2 * i];
+  }
+  drillStepFromApp((uint8_t)rxFields[0], (DrillEnd)rxFields[1], (uint16_t)rxFields[2], ids, values, n);
+}
+
+// K,<servo> replies OK,K,<servo>,<c0>,...,<c12> (µs corrections, servoCal); with all the points
+// it sets them first and saves them to EEPROM. Not while running: the EEPROM writes block.
+static void rxFinishCal() {
+  if ((rxFieldCount != 1 && rxFieldCount != 1 + SERVO_CAL_POINTS) || rxFields[0] < SERVO_TILT ||
+      rxFields[0] > SERVO_PAN) {
+    TxLine(TX_REPLY).print(F("ERR,K,INVALID\n"));
+    return;
+  }
+  const uint8_t servo = (uint8_t)rxFields[0];
+  if (rxFieldCount > 1) {
+    for (uint8_t i = 1; i < rxFieldCount; i++) {
+      if (rxFields[i] < -SERVO_CAL_MAX_US || rxFields[i] > SERVO_CAL_MAX_US) {
+        TxLine(TX_REPLY).print(F("ERR,K,RANGE\n"));
+        return;
+      }
+    }
+    if (isRunning) {
+      TxLine(TX_REPLY).print(F("ERR,K,BUSY\n"));
       return;
     }
-    *endBlock = '\0';
-    // CONFIG: 26 ints (order same as app): panMode, tiltMode, panTarget*1000, ...
-    int v[26];
-    int n = 0;
-    char* p = lastBlock;
-    while (n < 26 && *p) {
-      v[n++] = atoi(p);
-      while (*p && *p != ',') p++;
-      if (*p == ',') p++;
+    for (uint8_t i = 0; i < SERVO_CAL_POINTS; i++) servoCal[servo][i] = (int8_t)rxFields[1 + i];
+    applyServoCal();
+    saveServoCalToEEPROM();
+  }
+  TxLine out(TX_REPLY);
+  out.print(F("OK,K,"));
+  out.print(servo);
+  for (uint8_t i = 0; i < SERVO_CAL_POINTS; i++) {
+    out.print(',');
+    out.print((int)servoCal[servo][i]);
+  }
+  out.print('\n');
+}
+
+static void rxFinishName() {
+  btDeviceName[rxNameLen] = '\0';
+  btConnected = true;
+  stateHighSinceMs = 0;
+  stateNotConnectedSinceMs = 0;
+  TxLine out(TX_LOG);
+  out.print(F("[BT] CONNECTED name="));
+  if (btDeviceName[0]) out.print(btDeviceName);
+  else out.print(F("(none)"));
+  out.print('\n');
+}
+
+// W,<slot>[,<name>]: the record is written in the background (profilesPoll)
+static void profileSaveFromApp() {
+  const bool slotOk = rxWordLen >= 3 && rxWord[1] == ',' && rxWord[2] >= '1' && rxWord[2] <= '0' + PROFILE_SLOTS &&
+                      (rxWordLen == 3 || rxWord[3] == ',');
+  if (!slotOk) {
+    TxLine(TX_REPLY).print(F("ERR,W,SLOT\n"));
+    return;
+  }
+  const uint8_t slot = (uint8_t)(rxWord[2] - '0');
+  if (!profileSave(slot, rxWordLen > 4 ? rxWord + 4 : "")) {
+    TxLine(TX_REPLY).print(F("ERR,W,BUSY\n"));
+    return;
+  }
+  TxLine out(TX_REPLY);
+  out.print(F("OK,W,"));
+  out.print(slot);
+  out.print('\n');
+}
+
+// L = slot names, OK,L,<name 1>,...,<name PROFILE_SLOTS> (empty when unused); L,<slot> = load it
+static void profileLoadFromApp() {
+  if (rxWordLen == 1) {
+    TxLine out(TX_REPLY);
+    out.print(F("OK,L"));
+    for (uint8_t s = 1; s <= PROFILE_SLOTS; s++) {
+      out.print(',');
+      out.print(profileName(s));
     }
-    if (n >= 26) {
-      cfg.panMode = intToAxisMode(v[0]);
-      cfg.tiltMode = intToAxisMode(v[1]);
-      cfg.panTarget = (float)v[2] / 1000.0f;
-      cfg.tiltTarget = (float)v[3] / 1000.0f;
-      cfg.panMin = (float)v[4] / 1000.0f;
-      cfg.panMax = (float)v[5] / 1000.0f;
-      cfg.tiltMin = (float)v[6] / 1000.0f;
-      cfg.tiltMax = (float)v[7] / 1000.0f;
-      clampFloat(cfg.panTarget, -1.0f, 1.0f);
-      clampFloat(cfg.tiltTarget, -1.0f, 1.0f);
-      clampFloat(cfg.panMin, -1.0f, 1.0f);
-      clampFloat(cfg.panMax, -1.0f, 1.0f);
-      clampFloat(cfg.tiltMin, -1.0f, 1.0f);
-      clampFloat(cfg.tiltMax, -1.0f, 1.0f);
-
-      cfg.panAuto1Speed = (float)v[8] / 1000.0f;
-      cfg.panAuto2Step = (float)v[9] / 1000.0f;
-      cfg.panAuto2PauseMs = (unsigned long)v[10];
-      cfg.tiltAuto1Speed = (float)v[11] / 1000.0f;
-      cfg.tiltAuto2Step = (float)v[12] / 1000.0f;
-      cfg.tiltAuto2PauseMs = (unsigned long)v[13];
-      clampFloat(cfg.panAuto1Speed, 0.005f, 0.08f);
-      clampFloat(cfg.panAuto2Step, 0.05f, 0.5f);
-      clampFloat(cfg.tiltAuto1Speed, 0.005f, 0.08f);
-      clampFloat(cfg.tiltAuto2Step, 0.05f, 0.5f);
-      clampUL(cfg.panAuto2PauseMs, 100UL, 10000UL);
-      clampUL(cfg.tiltAuto2PauseMs, 100UL, 10000UL);
-
-      cfg.panRandomMinDist = (float)v[14] / 1000.0f;
-      cfg.panRandomPauseMs = (unsigned long)v[15];
-      cfg.tiltRandomMinDist = (float)v[16] / 1000.0f;
-      cfg.tiltRandomPauseMs = (unsigned long)v[17];
-      clampFloat(cfg.panRandomMinDist, 0.1f, 0.5f);
-      clampFloat(cfg.tiltRandomMinDist, 0.1f, 0.5f);
-      clampUL(cfg.panRandomPauseMs, 500UL, 30000UL);
-      clampUL(cfg.tiltRandomPauseMs, 500UL, 30000UL);
-
-      cfg.launcherPower = v[18];
-      cfg.spinMode = intToSpinMode(v[19]);
-      cfg.spinIntensity = v[20];
-      cfg.feederMode = intToFeederMode(v[21]);
-      cfg.feederSpeed = v[22];
-      cfg.feederCustomOnMs = (unsigned long)v[23];
-      cfg.feederCustomOffMs = (unsigned long)v[24];
-      cfg.timerIndex = v[25];
-
-      clampInt(cfg.launcherPower, 0, 255);
-      clampInt(cfg.spinIntensity, 0, 512);
-      clampInt(cfg.feederSpeed, 0, 255);
-      clampInt(cfg.timerIndex, 0, 5);
-      clampUL(cfg.feederCustomOnMs, 100UL, 10000UL);
-      clampUL(cfg.feederCustomOffMs, 100UL, 10000UL);
-
-      if (!isRunning) {
-        updateServos(cfg.panTarget, cfg.tiltTarget);
+    out.print('\n');
+    return;
+  }
+  if (rxWordLen != 3 || rxWord[1] != ',' || rxWord[2] < '0' || rxWord[2] > '0' + PROFILE_SLOTS) {
+    TxLine(TX_REPLY).print(F("ERR,L,SLOT\n"));
+    return;
+  }
+  const uint8_t slot = (uint8_t)(rxWord[2] - '0');
+  if (drillCurrentStep() != 0) {
+    TxLine(TX_REPLY).print(F("ERR,L,BUSY\n"));
+    return;
+  }
+  if (!profileLoad(slot)) {
+    TxLine(TX_REPLY).print(F("ERR,L,EMPTY\n"));
+    return;
+  }
+  TxLine out(TX_REPLY);
+  out.print(F("OK,L,"));
+  out.print(slot);
+  out.print(',');
+  out.print(configRevision);
+  out.print('\n');
+}
+
+static void rxRunWord() {
+  rxWord[rxWordLen] = '\0';
+  switch (rxWord[0]) {
+    case 'S':
+      if (rxWordLen == 1 || strncmp_P(rxWord, PSTR("START"), 5) == 0) {
+        startFromApp();
+      } else if (strncmp_P(rxWord, PSTR("STOP"), 4) == 0) {
+        stopFromApp();
       }
-      BT_SERIAL.print(F("OK,C\n"));
+      break;
+    case 'P':
+      if (rxWordLen == 1) stopFromApp();
+      break;
+    case 'D':
+      if (rxWordLen == 1 || strncmp_P(rxWord, PSTR("DISCONNECT"), 8) == 0) setBTDisconnected();
+      break;
+    case 'V':
+      // Protocol query: binary frames (bt_frame.h) are accepted from this version on, and the app
+      // that asks can parse telemetry frames
+      if (rxWordLen == 1) {
+        setTelemetryEnabled(true);
+        TxLine out(TX_REPLY);
+        out.print(F("OK,V,"));
+        out.print(BT_FRAME_VERSION);
+        out.print('\n');
+      }
+      break;
+    case 'T':
+      // T = loop timing histograms to the app, T,S = same to Serial, T,R = reset
+      if (rxWordLen != 1 && rxWord[1] != ',') break;
+      if (rxWordLen >= 3 && rxWord[2] == 'R') {
+        profReset();
+        TxLine(TX_REPLY).print(F("OK,T\n"));
+      } else if (rxWordLen >= 3 && rxWord[2] == 'S') {
+        TxLine out(TX_LOG, true);  // asked for, so not dropped like other debug output
+        profDump(out, F("[PROF] "));
+      } else {
+        TxLine out(TX_REPLY);
+        profDump(out, F("T,"));
+      }
+      break;
+    case 'M':
+      // M = RAM budget to the app, M,S = same to Serial
+      if (rxWordLen != 1 && rxWord[1] != ',') break;
+      if (rxWordLen >= 3 && rxWord[2] == 'S') {
+        TxLine out(TX_LOG, true);
+        ramReport(out, F("[RAM] "));
+      } else {
+        TxLine out(TX_REPLY);
+        ramReport(out, F("M,"));
+      }
+      break;
+    case 'W':
+      profileSaveFromApp();
+      break;
+    case 'L':
+      profileLoadFromApp();
+      break;
+  }
+}
+
+static void rxEndLine() {
+  switch (rxState) {
+    case RX_WORD:
+      rxRunWord();
+      break;
+    case RX_NAME:
+      rxFinishName();
+      break;
+    case RX_FIELDS:
+      if (rxFieldsKind == RX_FIELDS_CONFIG) {
+        TxLine(TX_LOG).print(F("[BT] Config rejected: incomplete (block does not end with '>')\n"));
+        TxLine(TX_REPLY).print(F("ERR,C,INCOMPLETE\n"));
+      } else if (rxFieldsKind == RX_FIELDS_DELTA) {
+        if (rxFieldAny) rxPushField();
+        rxFinishDelta();
+      } else if (rxFieldsKind == RX_FIELDS_DRILL) {
+        if (rxFieldAny) rxPushField();
+        rxFinishDrill();
+      } else if (rxFieldsKind == RX_FIELDS_CAL) {
+        if (rxFieldAny) rxPushField();
+        rxFinishCal();
+      } else {
+        if (rxFieldAny) rxPushField();
+        if (rxFieldCount >= 3) {
+          applyAimSampleMilli(rxFields[0], rxFields[1], (uint16_t)rxFields[2]);
+        } else {
+          applyAimMilli(rxFieldCount > 0 ? rxFields[0] : 0, rxFieldCount > 1 ? rxFields[1] : 0);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  rxState = RX_LINE_START;
+}
+
+// "<C," can start in any line except inside a name or word; it restarts the config block.
+static bool rxTrackConfigMarker(char c) {
+  if (c == '<') {
+    rxConfigMatch = 1;
+  } else if (rxConfigMatch == 1 && c == 'C') {
+    rxConfigMatch = 2;
+  } else if (rxConfigMatch == 2 && c == ',') {
+    rxConfigMatch = 0;
+    rxBeginFields(RX_FIELDS_CONFIG);
+    return true;
+  } else {
+    rxConfigMatch = 0;
+  }
+  return false;
+}
+
+static void rxByte(char c) {
+  if (btFrameActive()) {
+    btFrameByte((uint8_t)c);
+    return;
+  }
+  if ((uint8_t)c == BT_FRAME_SYNC) {
+    rxState = RX_LINE_START;  // drop any partial text line
+    btFrameBegin();
+    return;
+  }
+
+  if (c == '\n' || c == '\r') {
+    if (rxState != RX_LINE_START) rxEndLine();
+    return;
+  }
+
+  if (rxState == RX_LINE_START) {
+    rxLinePos = 0;
+    rxPrev = 0;
+    rxConfigMatch = 0;
+    if (c == 'S' || c == 'P' || c == 'D' || c == 'T' || c == 'V' || c == 'W' || c == 'L' || c == 'M') {
+      rxWordLen = 0;
+      rxState = RX_WORD;
     } else {
-      Serial.println(F("[BT] Config rejected: invalid (expected 26 fields)"));
-      BT_SERIAL.print(F("ERR,C,INVALID\n"));
+      rxState = RX_SCAN;
     }
-    lineLen = 0;
-    return;
   }
 
-  lineLen = 0;
+  switch (rxState) {
+    case RX_WORD:
+      if (rxWordLen < BT_WORD_MAX - 1) rxWord[rxWordLen++] = c;
+      break;
+
+    case RX_SCAN:
+      if (rxTrackConfigMarker(c)) break;
+      if (c == ',' && rxPrev == 'A' && rxLinePos == 1) {
+        rxBeginFields(RX_FIELDS_AIM);
+      } else if (c == ',' && rxPrev == 'U' && rxLinePos == 1) {
+        rxBeginFields(RX_FIELDS_DELTA);
+      } else if (c == ',' && rxPrev == 'Q' && rxLinePos == 1) {
+        rxBeginFields(RX_FIELDS_DRILL);
+      } else if (c == ',' && rxPrev == 'K' && rxLinePos == 1) {
+        rxBeginFields(RX_FIELDS_CAL);
+      } else if (c == ',' && rxPrev == 'N') {
+        rxNameLen = 0;
+        rxState = RX_NAME;
+      }
+      break;
+
+    case RX_NAME:
+      if (c == ',') {
+        rxFinishName();
+        rxState = RX_SKIP;
+      } else if (rxNameLen < BT_DEVICE_NAME_LEN) {
+        btDeviceName[rxNameLen++] = c;
+      }
+      break;
+
+    case RX_FIELDS:
+      if (rxTrackConfigMarker(c)) break;
+      if (c == '<') break;  // possible start of a newer block; not part of a field
+      if (rxFieldsKind == RX_FIELDS_CONFIG && c == '>') {
+        rxFinishConfig();
+        rxState = RX_SKIP;
+      } else if (c == ',') {
+        rxPushField();
+      } else {
+        rxFieldByte(c);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  rxPrev = c;
+  if (rxLinePos < 255) rxLinePos++;
 }
 
-void notifyLiveAimToApp(float pan, float tilt) {
-  int p1000 = (int)(pan * 1000.0f);
-  int t1000 = (int)(tilt * 1000.0f);
-  BT_SERIAL.print(F("A,"));
-  BT_SERIAL.print(p1000);
-  BT_SERIAL.print(F(","));
-  BT_SERIAL.print(t1000);
-  BT_SERIAL.print('\n');
+void notifyLiveAimToApp(q16_t pan, q16_t tilt) {
+  int p1000 = (int)q16ToMilli(pan);
+  int t1000 = (int)q16ToMilli(tilt);
+  TxLine out(TX_STREAM);  // one message: dropped whole, never a partial line
+  out.print(F("A,"));
+  out.print(p1000);
+  out.print(',');
+  out.print(t1000);
+  out.print('\n');
 }
 
 void initBTCommand() {
   pinMode(BT_STATE_PIN, INPUT);
-  BT_SERIAL.begin(BT_BAUD);
-  lineLen = 0;
-
-#if BT_AT_INIT_AT_STARTUP
-  delay(500);
-  for (int i = 0; i < 10; i++) BT_SERIAL.print(F("xxxxxxxx"));
-  delay(100);
-  BT_SERIAL.print(F("AT+NAMESpinRobot"));
-  delay(200);
-  BT_SERIAL.print(F("AT+RESET"));
-  delay(2500);
-#endif
+  rxState = RX_LINE_START;
+  btAtBegin();  // AT handshake runs from processBTInput(); setup() does not wait for it
 }
 
 void processBTInput() {
+  btAtPoll();
+  if (!btAtReady()) return;
+  btFramePoll();
   while (BT_SERIAL.available()) {
     char c = (char)BT_SERIAL.read();
-    if (c == '\n' || c == '\r') {
-      if (lineLen > 0) processLine();
-      continue;
-    }
-    if (lineLen < BT_LINE_BUF_SIZE - 1) {
-      lineBuf[lineLen++] = c;
-    } else {
-      lineLen = 0;  // overflow, descarta linha
-    }
+#if BT_LOG_RX
+    logRxByte(c);
+#endif
+    rxByte(c);
   }
 }
@@ -2,14 +2,20 @@
 #define BT_COMMAND_H
 
 #include "config.h"
+#include "drill.h"
 
 // BT state is owned only by this module. Screens/display must only READ via getBtConnected()
 // and getBtDeviceName(). State is updated on: (1) receiving "N,name" from app -> connected,
 // (2) updateBTState() -> sets connected when STATE pin HIGH. Robot never clears connected state.
 
 #define BT_SERIAL Serial1
-#define BT_BAUD 9600
-#define BT_LINE_BUF_SIZE 256
+#define BT_BAUD 9600  // HM-10 factory rate; bt_at.cpp negotiates BT_BAUD_FAST at boot
+#define BT_CONFIG_FIELDS 28
+#define BT_CONFIG_FIELDS_MIN 26  // full configs from apps before feederBpm/ballLimit; those keep their values
+
+// 1 = echo received bytes to Serial as "[BT RX] ..." lines, queued as TX_LOG messages (tx_queue.h):
+// a line that does not fit is dropped and counted in txDropped[TX_LOG].
+#define BT_LOG_RX 0
 
 #define BT_AT_INIT_AT_STARTUP 1
 
@@ -20,6 +26,28 @@ void updateBTState();
 bool getBtConnected(void);
 const char* getBtDeviceName();
 
-void notifyLiveAimToApp(float pan, float tilt);
+void notifyLiveAimToApp(q16_t pan, q16_t tilt);
+
+// Bumped on every applied full or delta config, echoed in OK,C / OK,U, and sent in telemetry.
+// configRevisionPoll() also bumps it when cfg changed on the robot (OLED menus, drill steps,
+// profile load), so an ack that is not the app's last revision + 1, or telemetry with another
+// revision, tells the app its delta baseline is stale.
+extern uint16_t configRevision;
+void configRevisionPoll();  // before a config update and with each telemetry frame
+
+// App actions, shared by the text parser and binary frames (bt_frame.cpp)
+void applyConfigFields(const int* v, uint8_t n);  // first n (>= BT_CONFIG_FIELDS_MIN) values in <C,...> order; replies OK,C,<rev> (ERR,C,BUSY during a drill)
+void applyConfigField(uint8_t id, int value);  // one field by its <C,...> index (< BT_CONFIG_FIELDS)
+int configFieldValue(uint8_t id);              // inverse of applyConfigField: cfg as the app sends it
+void applyStoredConfig(const int* v);          // all BT_CONFIG_FIELDS values of a profile (profiles.h); no reply
+bool beginConfigDelta();                       // before the applyConfigField calls of an app delta; false (ERR,U,BUSY sent) during a drill
+void finishConfigDelta();                      // after applyConfigField calls; replies OK,U,<rev>
+void applyAimMilli(int p1000, int t1000);
+void applyAimSampleMilli(int p1000, int t1000, uint16_t appMs);
+void drillStepFromApp(uint8_t step, DrillEnd end, uint16_t amount, const uint8_t* ids, const int* values,
+                      uint8_t n);      // ids < BT_CONFIG_FIELDS; replies OK,Q,<steps> / ERR,Q,<reason>
+void drillClearFromApp();              // replies OK,Q,0
+void startFromApp();                   // replies OK,S
+void stopFromApp();
 
 #endif
@@ -0,0 +1,265 @@
+#include "bt_frame.h"
+#include "bt_command.h"
+#include "config.h"
+#include "tx_queue.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+// Wire width of each config field, in <C,...> order: 1 = u8, 2 = s16, 3 = u16.
+static const uint8_t CONFIG_FIELD_WIDTH[BT_CONFIG_FIELDS] PROGMEM = {
+  1, 1,              // panMode, tiltMode
+  2, 2, 2, 2, 2, 2,  // panTarget, tiltTarget, panMin, panMax, tiltMin, tiltMax (*1000)
+  2, 2, 3,           // panAuto1Speed, panAuto2Step (*1000), panAuto2PauseMs
+  2, 2, 3,           // tiltAuto1Speed, tiltAuto2Step (*1000), tiltAuto2PauseMs
+  2, 3, 2, 3,        // panRandomMinDist (*1000), panRandomPauseMs, tiltRandomMinDist, tiltRandomPauseMs
+  1, 1, 3,           // launcherPower, spinMode, spinIntensity
+  1, 1, 3, 3,        // feederMode, feederSpeed, feederCustomOnMs, feederCustomOffMs
+  1,                 // timerIndex
+  1, 3               // feederBpm, ballLimit (frame version 4)
+};
+#define CONFIG_FRAME_PAYLOAD     CONFIG_PACKED_LEN
+#define CONFIG_FRAME_PAYLOAD_MIN 45  // BT_CONFIG_FIELDS_MIN fields
+
+enum FrameRxState : uint8_t { FR_IDLE, FR_VER, FR_TYPE, FR_LEN, FR_PAYLOAD, FR_CRC_LO, FR_CRC_HI };
+
+static FrameRxState frState = FR_IDLE;
+static uint8_t frType = 0;
+static uint8_t frLen = 0;
+static uint8_t frPos = 0;
+static uint8_t frPayload[BT_FRAME_MAX_PAYLOAD];
+static uint16_t frCrc = 0;
+static uint16_t frCrcRx = 0;
+static unsigned long frLastByteMs = 0;
+
+uint16_t crc16Ccitt(uint16_t crc, uint8_t b) {
+  crc ^= (uint16_t)b << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+static void frameReject(const __FlashStringHelper* reason) {
+  TxLine dbg(TX_LOG);
+  dbg.print(F("[BT] Frame rejected: "));
+  dbg.print(reason);
+  dbg.print('\n');
+  TxLine out(TX_REPLY);
+  out.print(F("ERR,F,"));
+  out.print(reason);
+  out.print('\n');
+  frState = FR_IDLE;
+}
+
+static int16_t readS16(const uint8_t* p) {
+  return (int16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+static int readU16AsInt(const uint8_t* p) {
+  uint16_t v = (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+  return (v > 32767U) ? 32767 : (int)v;  // same saturation as the text parser
+}
+
+static int readField(uint8_t id, const uint8_t*& p) {
+  uint8_t w = pgm_read_byte(&CONFIG_FIELD_WIDTH[id]);
+  int v;
+  if (w == 1) { v = *p; p += 1; }
+  else if (w == 2) { v = readS16(p); p += 2; }
+  else { v = readU16AsInt(p); p += 2; }
+  return v;
+}
+
+void unpackConfig(const uint8_t* p, uint8_t n, int* v) {
+  for (uint8_t i = 0; i < n; i++) v[i] = readField(i, p);
+}
+
+void packConfig(uint8_t* out) {
+  for (uint8_t id = 0; id < BT_CONFIG_FIELDS; id++) {
+    const int v = configFieldValue(id);
+    *out++ = (uint8_t)(v & 0xFF);
+    if (pgm_read_byte(&CONFIG_FIELD_WIDTH[id]) != 1) *out++ = (uint8_t)((uint16_t)v >> 8);
+  }
+}
+
+#define PAIRS_BAD_FIELD  -1
+#define PAIRS_BAD_LENGTH -2
+
+// Counts the { u8 id, value } pairs in p[0..len); the whole run is checked before anything is
+// applied, so a bad id never half-applies an update.
+static int checkFieldPairs(const uint8_t* p, uint8_t len) {
+  uint8_t pos = 0;
+  int pairs = 0;
+  while (pos < len) {
+    uint8_t id = p[pos];
+    if (id >= BT_CONFIG_FIELDS) return PAIRS_BAD_FIELD;
+    pos += 1 + (pgm_read_byte(&CONFIG_FIELD_WIDTH[id]) == 1 ? 1 : 2);
+    pairs++;
+  }
+  return pos == len ? pairs : PAIRS_BAD_LENGTH;
+}
+
+static void frameDelta() {
+  const int pairs = checkFieldPairs(frPayload, frLen);
+  if (pairs == PAIRS_BAD_FIELD) {
+    TxLine(TX_REPLY).print(F("ERR,U,FIELD\n"));
+    return;
+  }
+  if (pairs <= 0) {
+    TxLine(TX_REPLY).print(F("ERR,U,INVALID\n"));
+    return;
+  }
+  if (!beginConfigDelta()) return;
+  const uint8_t* p = frPayload;
+  while (p < frPayload + frLen) {
+    uint8_t id = *p++;
+    applyConfigField(id, readField(id, p));
+  }
+  finishConfigDelta();
+}
+
+// u8 step (0 = clear), u8 end, u16 amount, then field pairs as in a delta
+static void frameDrill() {
+  if (frLen == 1 && frPayload[0] == 0) {
+    drillClearFromApp();
+    return;
+  }
+  const int pairs = (frLen >= 4) ? checkFieldPairs(frPayload + 4, frLen - 4) : PAIRS_BAD_LENGTH;
+  if (pairs == PAIRS_BAD_FIELD) {
+    TxLine(TX_REPLY).print(F("ERR,Q,FIELD\n"));
+    return;
+  }
+  if (pairs < 0 || pairs > DRILL_MAX_FIELDS) {
+    TxLine(TX_REPLY).print(F("ERR,Q,INVALID\n"));
+    return;
+  }
+  uint8_t ids[DRILL_MAX_FIELDS];
+  int values[DRILL_MAX_FIELDS];
+  const uint8_t* p = frPayload + 4;
+  for (int i = 0; i < pairs; i++) {
+    ids[i] = *p++;
+    values[i] = readField(ids[i], p);
+  }
+  const uint16_t amount = (uint16_t)frPayload[2] | ((uint16_t)frPayload[3] << 8);
+  drillStepFromApp(frPayload[0], (DrillEnd)frPayload[1], amount, ids, values, (uint8_t)pairs);
+}
+
+static void frameDispatch() {
+  switch (frType) {
+    case BT_FRAME_CONFIG: {
+      if (frLen != CONFIG_FRAME_PAYLOAD && frLen != CONFIG_FRAME_PAYLOAD_MIN) {
+        TxLine(TX_REPLY).print(F("ERR,C,INVALID\n"));
+        return;
+      }
+      const uint8_t n = frLen == CONFIG_FRAME_PAYLOAD ? BT_CONFIG_FIELDS : BT_CONFIG_FIELDS_MIN;
+      int v[BT_CONFIG_FIELDS];
+      unpackConfig(frPayload, n, v);
+      applyConfigFields(v, n);
+      break;
+    }
+    case BT_FRAME_DELTA:
+      frameDelta();
+      break;
+    case BT_FRAME_DRILL:
+      frameDrill();
+      break;
+    case BT_FRAME_AIM:
+      if (frLen == 4) {
+        applyAimMilli(readS16(frPayload), readS16(frPayload + 2));
+      } else if (frLen == 6) {
+        applyAimSampleMilli(readS16(frPayload), readS16(frPayload + 2), (uint16_t)readS16(frPayload + 4));
+      } else {
+        frameReject(F("LEN"));
+      }
+      break;
+    case BT_FRAME_START:
+      startFromApp();
+      break;
+    case BT_FRAME_STOP:
+      stopFromApp();
+      break;
+    default:
+      frameReject(F("TYPE"));
+      break;
+  }
+}
+
+bool btFrameSend(uint8_t type, const uint8_t* payload, uint8_t len) {
+  if (len > BT_FRAME_MAX_PAYLOAD) return false;
+  uint8_t frame[BT_FRAME_MAX_PAYLOAD + 6];
+  frame[0] = BT_FRAME_SYNC;
+  frame[1] = BT_FRAME_TX_VERSION;
+  frame[2] = type;
+  frame[3] = len;
+  memcpy(frame + 4, payload, len);
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 1; i < len + 4; i++) crc = crc16Ccitt(crc, frame[i]);
+  frame[len + 4] = (uint8_t)(crc & 0xFF);
+  frame[len + 5] = (uint8_t)(crc >> 8);
+  return txQueue(TX_STREAM, frame, len + 6);
+}
+
+bool btFrameActive() {
+  return frState != FR_IDLE;
+}
+
+void btFrameBegin() {
+  frState = FR_VER;
+  frCrc = 0xFFFF;
+  frLastByteMs = millis();
+}
+
+void btFrameByte(uint8_t c) {
+  frLastByteMs = millis();
+  switch (frState) {
+    case FR_VER:
+      if (c == 0 || c > BT_FRAME_VERSION) {
+        frameReject(F("VER"));
+        return;
+      }
+      frCrc = crc16Ccitt(frCrc, c);
+      frState = FR_TYPE;
+      break;
+    case FR_TYPE:
+      frType = c;
+      frCrc = crc16Ccitt(frCrc, c);
+      frState = FR_LEN;
+      break;
+    case FR_LEN:
+      if (c > BT_FRAME_MAX_PAYLOAD) {
+        frameReject(F("LEN"));
+        return;
+      }
+      frLen = c;
+      frPos = 0;
+      frCrc = crc16Ccitt(frCrc, c);
+      frState = (frLen > 0) ? FR_PAYLOAD : FR_CRC_LO;
+      break;
+    case FR_PAYLOAD:
+      frPayload[frPos++] = c;
+      frCrc = crc16Ccitt(frCrc, c);
+      if (frPos >= frLen) frState = FR_CRC_LO;
+      break;
+    case FR_CRC_LO:
+      frCrcRx = c;
+      frState = FR_CRC_HI;
+      break;
+    case FR_CRC_HI:
+      frCrcRx |= (uint16_t)c << 8;
+      frState = FR_IDLE;
+      if (frCrcRx != frCrc) {
+        frameReject(F("CRC"));
+        return;
+      }
+      frameDispatch();
+      break;
+    default:
+      frState = FR_IDLE;
+      break;
+  }
+}
+
+void btFramePoll() {
+  if (frState != FR_IDLE && (millis() - frLastByteMs) >= BT_FRAME_TIMEOUT_MS) {
+    frameReject(F("TIMEOUT"));
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef BT_FRAME_H
+#define BT_FRAME_H
+
+#include <Arduino.h>
+
+// Binary frames, accepted alongside the text protocol on Serial1. The app asks with "V" and
+// switches to frames when the reply is OK,V,<version> >= its own. Layout (multi-byte values
+// little-endian):
+//   SYNC(0xA5) VER TYPE LEN payload[LEN] CRC16
+// CRC16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over VER..payload. Replies stay text
+// (OK,C,<rev> / OK,U,<rev> / OK,S / ERR,F,<reason>) so the app keeps one line reader for both
+// directions.
+
+#define BT_FRAME_SYNC        0xA5
+#define BT_FRAME_VERSION     4    // 2: timestamped aim frames, 3: drill frames, 4: 28 config fields; older frames still accepted
+#define BT_FRAME_TX_VERSION  2    // robot -> app frames: unchanged since 2, and apps reject newer versions
+#define BT_FRAME_MAX_PAYLOAD 64
+#define BT_FRAME_TIMEOUT_MS  200UL  // partial frame dropped after this long without a byte
+
+enum BtFrameType : uint8_t {
+  BT_FRAME_CONFIG = 0x01,  // 28 config fields packed per CONFIG_FIELD_WIDTH (48 bytes; 26 fields / 45 bytes before v4)
+  BT_FRAME_AIM    = 0x02,  // s16 pan*1000, s16 tilt*1000 [, u16 app ms: streamed sample]
+  BT_FRAME_START  = 0x03,
+  BT_FRAME_STOP   = 0x04,
+  BT_FRAME_DELTA  = 0x05,  // repeated { u8 field id, value per CONFIG_FIELD_WIDTH[id] }
+  BT_FRAME_DRILL  = 0x06,  // u8 step (0 = clear), u8 DrillEnd, u16 amount, then pairs as in DELTA
+
+  // Robot -> app (high bit set)
+  BT_FRAME_TELEMETRY = 0x81  // see telemetry.h
+};
+
+bool btFrameActive();
+void btFrameBegin();          // SYNC seen
+void btFrameByte(uint8_t c);  // next byte while active
+void btFramePoll();           // drops a stalled partial frame
+
+// Robot -> app frame, same layout. Queued whole on TX_STREAM (tx_queue.h); returns false (nothing
+// sent) when the stream ring is full, so callers never wait on the UART.
+bool btFrameSend(uint8_t type, const uint8_t* payload, uint8_t len);
+
+uint16_t crc16Ccitt(uint16_t crc, uint8_t b);
+
+// Config fields packed per CONFIG_FIELD_WIDTH, as in a BT_FRAME_CONFIG payload. profiles.cpp
+// stores the same layout in EEPROM.
+#define CONFIG_PACKED_LEN 48
+void packConfig(uint8_t* out);                           // cfg -> CONFIG_PACKED_LEN bytes
+void unpackConfig(const uint8_t* p, uint8_t n, int* v);  // first n fields, in <C,...> order
+
+#endif
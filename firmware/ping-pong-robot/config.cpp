@@ -1,39 +1,63 @@
 #include "config.h"
+#include "flash_str.h"
 
-const char* axisModeName(AxisMode m) {
-  switch (m) {
-    case AXIS_LIVE: return "LIVE";
-    case AXIS_AUTO1: return "AUTO1";
-    case AXIS_AUTO2: return "AUTO2";
-    case AXIS_RANDOM: return "RANDOM";
-    default: return "?";
-  }
+// Names are PROGMEM tables indexed by the enum (flash_str.h)
+static const char AXIS_NAME_LIVE[] PROGMEM = "LIVE";
+static const char AXIS_NAME_AUTO1[] PROGMEM = "AUTO1";
+static const char AXIS_NAME_AUTO2[] PROGMEM = "AUTO2";
+static const char AXIS_NAME_RANDOM[] PROGMEM = "RANDOM";
+static const char* const AXIS_MODE_NAMES[AXIS_MODE_COUNT] PROGMEM = {
+  AXIS_NAME_LIVE, AXIS_NAME_AUTO1, AXIS_NAME_AUTO2, AXIS_NAME_RANDOM
+};
+
+static const char FEED_LABEL_CONT[] PROGMEM = "CONT";
+static const char FEED_LABEL_P11[] PROGMEM = "P1/1";
+static const char FEED_LABEL_P21[] PROGMEM = "P2/1";
+static const char FEED_LABEL_P22[] PROGMEM = "P2/2";
+static const char FEED_LABEL_CUSTOM[] PROGMEM = "CUSTOM";
+static const char FEED_LABEL_BPM[] PROGMEM = "BPM";
+static const char* const FEEDER_MODE_LABELS[FEED_MODE_COUNT] PROGMEM = {
+  FEED_LABEL_CONT, FEED_LABEL_P11, FEED_LABEL_P21, FEED_LABEL_P22, FEED_LABEL_CUSTOM, FEED_LABEL_BPM
+};
+
+static const char SPIN_NAME_NONE[] PROGMEM = "NONE";
+static const char SPIN_NAME_N[] PROGMEM = "N";
+static const char SPIN_NAME_NE[] PROGMEM = "NE";
+static const char SPIN_NAME_E[] PROGMEM = "E";
+static const char SPIN_NAME_SE[] PROGMEM = "SE";
+static const char SPIN_NAME_S[] PROGMEM = "S";
+static const char SPIN_NAME_SW[] PROGMEM = "SW";
+static const char SPIN_NAME_W[] PROGMEM = "W";
+static const char SPIN_NAME_NW[] PROGMEM = "NW";
+static const char* const SPIN_MODE_NAMES[SPIN_MODE_COUNT] PROGMEM = {
+  SPIN_NAME_NONE, SPIN_NAME_N, SPIN_NAME_NE, SPIN_NAME_E, SPIN_NAME_SE,
+  SPIN_NAME_S, SPIN_NAME_SW, SPIN_NAME_W, SPIN_NAME_NW
+};
+
+#define TIMER_COUNT 6
+static const char TIMER_NAME_OFF[] PROGMEM = "OFF";
+static const char TIMER_NAME_15S[] PROGMEM = "15s";
+static const char TIMER_NAME_30S[] PROGMEM = "30s";
+static const char TIMER_NAME_1M[] PROGMEM = "1m";
+static const char TIMER_NAME_2M[] PROGMEM = "2m";
+static const char TIMER_NAME_5M[] PROGMEM = "5m";
+static const char* const TIMER_NAMES[TIMER_COUNT] PROGMEM = {
+  TIMER_NAME_OFF, TIMER_NAME_15S, TIMER_NAME_30S, TIMER_NAME_1M, TIMER_NAME_2M, TIMER_NAME_5M
+};
+
+const __FlashStringHelper* axisModeName(AxisMode m) {
+  if ((unsigned)m >= AXIS_MODE_COUNT) return F("?");
+  return flashStr(AXIS_MODE_NAMES, (uint8_t)m);
 }
 
-const char* feederModeLabel(FeederMode m) {
-  switch (m) {
-    case FEED_CONTINUOUS: return "CONT";
-    case FEED_PULSE_1_1:  return "P1/1";
-    case FEED_PULSE_2_1:  return "P2/1";
-    case FEED_PULSE_2_2:  return "P2/2";
-    case FEED_CUSTOM:     return "CUSTOM";
-    default: return "?";
-  }
+const __FlashStringHelper* feederModeLabel(FeederMode m) {
+  if ((unsigned)m >= FEED_MODE_COUNT) return F("?");
+  return flashStr(FEEDER_MODE_LABELS, (uint8_t)m);
 }
 
-const char* spinModeName(SpinMode s) {
-  switch (s) {
-    case SPIN_NONE: return "NONE";
-    case SPIN_N:    return "N";
-    case SPIN_NE:   return "NE";
-    case SPIN_E:    return "E";
-    case SPIN_SE:   return "SE";
-    case SPIN_S:    return "S";
-    case SPIN_SW:   return "SW";
-    case SPIN_W:    return "W";
-    case SPIN_NW:   return "NW";
-    default: return "?";
-  }
+const __FlashStringHelper* spinModeName(SpinMode s) {
+  if ((unsigned)s >= SPIN_MODE_COUNT) return F("?");
+  return flashStr(SPIN_MODE_NAMES, (uint8_t)s);
 }
 
 int spinModeToAngleDeg(SpinMode s) {
@@ -51,16 +75,9 @@ int spinModeToAngleDeg(SpinMode s) {
   }
 }
 
-const char* timerNameByIndex(int idx) {
-  switch (idx) {
-    case 0: return "OFF";
-    case 1: return "15s";
-    case 2: return "30s";
-    case 3: return "1m";
-    case 4: return "2m";
-    case 5: return "5m";
-    default: return "?";
-  }
+const __FlashStringHelper* timerNameByIndex(int idx) {
+  if (idx < 0 || idx >= TIMER_COUNT) return F("?");
+  return flashStr(TIMER_NAMES, (uint8_t)idx);
 }
 
 unsigned long timerMsByIndex(int idx) {
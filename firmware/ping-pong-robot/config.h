@@ -1,6 +1,8 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include "fixedpoint.h"
+
 // ================= OLED =================
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
@@ -19,17 +21,75 @@
 // ================= Layout =================
 #define BODY_Y 16
 
+// ================= Display refresh =================
+// Minimum time between OLED frames. Frames are also dirty-checked per 8-row page, so only
+// pages that changed go over I2C (a full 1 KB push takes ~25 ms of loop time).
+#define OLED_FRAME_MS_RUNNING 50   // 20 FPS while a drill runs
+#define OLED_FRAME_MS_MENU    33   // ~30 FPS on menus
+#define OLED_I2C_CLOCK 400000UL
+#define OLED_REFRESH_FRAMES 8      // every 8th frame one page goes out even if its hash is unchanged
+
 // ================= Input tuning =================
 #define DEADZONE 70
 #define REPEAT_MS 140
 
 // incremental aim tuning
-#define AIM_STEP 0.025f
-#define AIM_FAST 2.8f
+#define AIM_STEP Q16(0.025)
+#define AIM_FAST Q16(2.8)
+
+// ================= Control loop =================
+// Aim, servos and motors run on a fixed-rate tick driven by a micros() accumulator in loop();
+// UI rendering and BT parsing run in the time left over.
+#define CONTROL_TICK_US 5000UL       // 200 Hz
+#define CONTROL_MAX_CATCHUP 4        // ticks run back-to-back after a long UI pass before the backlog is dropped
+// AUTO1 speed and AIM_STEP were tuned per loop() pass at ~25 ms; they are scaled to the tick.
+#define CONTROL_REF_PERIOD_US 25000UL
+#define CONTROL_TICK_SCALE(q) ((q16_t)((int32_t)(q) * (int32_t)CONTROL_TICK_US / (int32_t)CONTROL_REF_PERIOD_US))
+
+// Launcher ramp (M1..M3): PWM change per second, and per control tick. 0 -> 255 takes ~0.4 s,
+// which keeps the start-up and spin-change current within a 7.5 V supply.
+#define LAUNCHER_SLEW_PER_S 600
+#define LAUNCHER_SLEW_PER_TICK ((int)((LAUNCHER_SLEW_PER_S * CONTROL_TICK_US + 999999UL) / 1000000UL))
+
+// Launcher wheel tachometers (tach.h): one hall / IR pulse per wheel turn, on port K pin-change
+// interrupts (the Mega's INT pins are taken by the shield, Serial1 and I2C). Off unless fitted;
+// with them a PI trim on top of the ramped PWM holds each wheel at its RPM setpoint.
+#ifndef LAUNCHER_TACH
+#define LAUNCHER_TACH 0
+#endif
+#define TACH_PIN_1 A10
+#define TACH_PIN_2 A11
+#define TACH_PIN_3 A12
+#define TACH_PULSES_PER_REV 1
+#define TACH_MIN_PERIOD_US 2000UL  // edges closer than this are bounce (30000 RPM at 1 pulse/turn)
+#define TACH_TIMEOUT_MS     150UL  // no edge for this long: wheel stopped
+#define TACH_FAULT_MS       500UL  // no edge this long while driven above LAUNCHER_RPM_MIN: run open loop
+#define LAUNCHER_RPM_AT_FULL 6000  // wheel speed at PWM 255 on a charged 7.5 V pack: setpoint = PWM * this / 255
+#define LAUNCHER_RPM_MIN      600  // below this the loop is off (tach too slow to follow)
+#define LAUNCHER_PI_KP_Q16    840  // PWM per RPM of error, Q16 (~1 PWM per 80 RPM)
+#define LAUNCHER_PI_KI_Q16     16  // PWM per RPM of error per control tick, Q16
+#define LAUNCHER_TRIM_MAX      80  // most PWM the loop adds or removes
+#define LAUNCHER_RPM_READY_PCT  5  // launcherAtTarget() once every wheel is within this much
+
+// Pan/tilt servo motion (motion.h): trapezoidal moves. MG996R with the head: ~0.18 s / 60 deg
+#define SERVO_MAX_DEG_PER_S    330
+#define SERVO_ACCEL_DEG_PER_S2 6000  // full speed after ~55 ms / 9 deg
 
 // Feeder M4 recua por este tempo (ms) ao iniciar partida; depois inicia no sentido configurado
 #define FEEDER_PULLBACK_MS 500UL
 
+// Feeder jam detection (jam.h): ball-exit sensor (IR break beam, LOW while a ball blocks it) at
+// the top of the feed tube. Off unless the sensor is fitted; without it every pulse looks jammed.
+#ifndef FEEDER_EXIT_SENSOR
+#define FEEDER_EXIT_SENSOR 0
+#endif
+#define FEEDER_EXIT_PIN 24
+#define FEEDER_JAM_MS           1500UL  // feeder ON time without a ball leaving before it counts as a jam,
+#define FEEDER_JAM_BALLS        2       // or this many ball intervals at the feeder speed if that is longer
+#define FEEDER_UNJAM_REVERSE_MS 300UL
+#define FEEDER_UNJAM_FORWARD_MS 300UL   // full-speed push after the reverse
+#define FEEDER_JAM_MAX_RETRIES  3       // un-jam cycles in a row without a ball; then the run stops
+
 // ================= UI States =================
 enum Screen {
   SCREEN_HOME = 0,
@@ -47,7 +107,8 @@ enum Screen {
   SCREEN_SETTINGS_MOTOR,
 
   SCREEN_PAN_EDIT,
-  SCREEN_TILT_EDIT
+  SCREEN_TILT_EDIT,
+  SCREEN_PROFILES
 };
 
 // ================= D-Pad events =================
@@ -68,6 +129,7 @@ enum FeederMode {
   FEED_PULSE_2_1,
   FEED_PULSE_2_2,
   FEED_CUSTOM,
+  FEED_BPM,        // one ball per pulse at feederBpm (motors.h: feederPulseTiming)
   FEED_MODE_COUNT
 };
 
@@ -90,29 +152,29 @@ struct Config {
   AxisMode panMode = AXIS_LIVE;
   AxisMode tiltMode = AXIS_LIVE;
 
-  float panTarget = 0.0f;
-  float tiltTarget = 0.0f;
+  q16_t panTarget = 0;
+  q16_t tiltTarget = 0;
 
-  // Limites de ângulo (-1 a 1) para AUTO1, AUTO2 e RANDOM
-  float panMin = -1.0f;
-  float panMax = 1.0f;
-  float tiltMin = -1.0f;
-  float tiltMax = 1.0f;
+  // Limites de ângulo (-1 a 1, Q16) para AUTO1, AUTO2 e RANDOM
+  q16_t panMin = -Q16_ONE;
+  q16_t panMax = Q16_ONE;
+  q16_t tiltMin = -Q16_ONE;
+  q16_t tiltMax = Q16_ONE;
 
-  // AUTO1 speed per tick (0.005 .. 0.08)
-  float panAuto1Speed = 0.035f;
-  float tiltAuto1Speed = 0.035f;
+  // AUTO1 speed per 25 ms (0.005 .. 0.08); CONTROL_TICK_SCALE() of it is applied every control tick
+  q16_t panAuto1Speed = Q16(0.035);
+  q16_t tiltAuto1Speed = Q16(0.035);
 
   // AUTO2 step size (0.05 .. 0.5), pause between steps (ms)
-  float panAuto2Step = 0.25f;
+  q16_t panAuto2Step = Q16(0.25);
   unsigned long panAuto2PauseMs = 1000UL;
-  float tiltAuto2Step = 0.25f;
+  q16_t tiltAuto2Step = Q16(0.25);
   unsigned long tiltAuto2PauseMs = 1000UL;
 
   // RANDOM: distância mínima entre alvos (0.1 .. 0.5), pausa entre movimentos (ms)
-  float panRandomMinDist = 0.2f;
+  q16_t panRandomMinDist = Q16(0.2);
   unsigned long panRandomPauseMs = 2000UL;
-  float tiltRandomMinDist = 0.2f;
+  q16_t tiltRandomMinDist = Q16(0.2);
   unsigned long tiltRandomPauseMs = 2000UL;
 
   int launcherPower = 255;  // 0..255 - velocidade máxima dos motores
@@ -123,19 +185,23 @@ struct Config {
   FeederMode feederMode = FEED_CONTINUOUS;
   unsigned long feederCustomOnMs = 1500;
   unsigned long feederCustomOffMs = 750;
+  int feederBpm = 60;       // 10..120 - alvo de bolas por minuto no modo BPM
 
   // 0=OFF, 1=15s, 2=30s, 3=1m, 4=2m, 5=5m
   int timerIndex = 0;
+  int ballLimit = 0;        // 0 = off; the run ends after this many balls (feederBallCount)
 };
 
 // ================= Name helpers =================
-const char* axisModeName(AxisMode m);
-const char* feederModeLabel(FeederMode m);
-const char* spinModeName(SpinMode s);
+// Names are flash strings (flash_str.h): print them, do not index them
+class __FlashStringHelper;
+const __FlashStringHelper* axisModeName(AxisMode m);
+const __FlashStringHelper* feederModeLabel(FeederMode m);
+const __FlashStringHelper* spinModeName(SpinMode s);
 int spinModeToAngleDeg(SpinMode s);  // -1 se NONE, senão 0..315
 
 // ================= Timer helpers =================
-const char* timerNameByIndex(int idx);
+const __FlashStringHelper* timerNameByIndex(int idx);
 unsigned long timerMsByIndex(int idx);
 
 #endif
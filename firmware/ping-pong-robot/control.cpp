@@ -0,0 +1,40 @@
+#include "control.h"
+#include "config.h"
+#include "logic.h"
+#include "aim_stream.h"
+#include "motion.h"
+
+unsigned long controlTickCount = 0;
+unsigned long controlOverruns = 0;
+
+static unsigned long controlNextUs = 0;
+
+void initControl() {
+  controlNextUs = micros();
+}
+
+static void controlTick() {
+  aimStreamTick();
+  updateRunningLogic();
+  updateAxisPreviewTargets();
+  motionTick();  // after everything that sets a servo target this tick
+  controlTickCount++;
+}
+
+uint8_t runControlTicks() {
+  const unsigned long now = micros();
+  uint8_t ran = 0;
+  while ((long)(now - controlNextUs) >= 0) {
+    if (ran >= CONTROL_MAX_CATCHUP) {
+      // Too far behind (long blocking call): drop the backlog instead of bursting ticks.
+      unsigned long behind = (now - controlNextUs) / CONTROL_TICK_US + 1;
+      controlOverruns += behind;
+      controlNextUs += behind * CONTROL_TICK_US;
+      break;
+    }
+    controlTick();
+    controlNextUs += CONTROL_TICK_US;
+    ran++;
+  }
+  return ran;
+}
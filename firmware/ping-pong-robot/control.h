@@ -0,0 +1,17 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <Arduino.h>
+
+// Fixed-rate control scheduler. loop() calls runControlTicks() around its background work
+// (BT parsing, UI); every CONTROL_TICK_US that has elapsed runs one control tick: aim
+// (streamed from the app/live/auto/preview), servos, launcher and feeder motors. Timing of drills therefore does not
+// depend on how long the current screen takes to render.
+
+extern unsigned long controlTickCount;
+extern unsigned long controlOverruns;  // ticks dropped because the loop fell too far behind
+
+void initControl();
+uint8_t runControlTicks();  // returns the number of ticks run
+
+#endif
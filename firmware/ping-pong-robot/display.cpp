@@ -1,36 +1,251 @@
 #include "display.h"
 #include "config.h"
 #include "bt_command.h"
+#include "motors.h"
+#include "tx_queue.h"
 #include <Wire.h>
 #include <Arduino.h>
 #include <math.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+OledPager display;
+
+// ================= Page renderer =================
+#define OLED_PAGES (SCREEN_HEIGHT / 8)
+#define OLED_WIRE_CHUNK 32  // AVR Wire buffer: control byte + 31 data bytes per transaction
+
+// Rows y..y+h-1 that fall in page, as a bit mask of the page byte
+static uint8_t pageRowMask(int16_t y, int16_t h, uint8_t page) {
+  int16_t top = y - (int16_t)page * 8;
+  int16_t bottom = top + h;
+  if (top < 0) top = 0;
+  if (bottom > 8) bottom = 8;
+  if (top >= bottom) return 0;
+  return (uint8_t)((0xFF << top) & (0xFF >> (8 - bottom)));
+}
+
+void OledPager::startPage(uint8_t page) {
+  page_ = page;
+  memset(buf_, 0, sizeof(buf_));
+  setCursor(0, 0);
+}
+
+void OledPager::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  const int16_t row = y - (int16_t)page_ * 8;
+  if ((uint16_t)x >= SCREEN_WIDTH || (uint16_t)row >= 8) return;
+  const uint8_t bit = (uint8_t)(1 << row);
+  switch (color) {
+    case SSD1306_WHITE: buf_[x] |= bit; break;
+    case SSD1306_BLACK: buf_[x] &= (uint8_t)~bit; break;
+    case SSD1306_INVERSE: buf_[x] ^= bit; break;
+  }
+}
+
+// Sets, clears or inverts the mask rows of columns x..x+w-1
+void OledPager::fillColumns(int16_t x, int16_t w, uint8_t mask, uint16_t color) {
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
+  if (w <= 0 || mask == 0) return;
+  uint8_t* p = buf_ + x;
+  switch (color) {
+    case SSD1306_WHITE: while (w--) *p++ |= mask; break;
+    case SSD1306_BLACK: while (w--) *p++ &= (uint8_t)~mask; break;
+    case SSD1306_INVERSE: while (w--) *p++ ^= mask; break;
+  }
+}
 
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+void OledPager::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillColumns(x, w, pageRowMask(y, 1, page_), color);
+}
+
+void OledPager::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillColumns(x, 1, pageRowMask(y, h, page_), color);
+}
+
+void OledPager::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  fillColumns(x, w, pageRowMask(y, h, page_), color);
+}
+
+void OledPager::fillScreen(uint16_t color) {
+  fillColumns(0, SCREEN_WIDTH, 0xFF, color);
+}
+
+// Adafruit_GFX::write() for the built-in font, except that a character whose text row misses
+// the page only moves the cursor
+size_t OledPager::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += textsize_y * 8;
+    return 1;
+  }
+  if (c == '\r') return 1;
+  if (wrap && (cursor_x + textsize_x * 6) > _width) {
+    cursor_x = 0;
+    cursor_y += textsize_y * 8;
+  }
+  const int16_t top = (int16_t)page_ * 8;
+  if (cursor_y < top + 8 && cursor_y + textsize_y * 8 > top) {
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+  }
+  cursor_x += textsize_x * 6;
+  return 1;
+}
+
+// Same power-up sequence as Adafruit_SSD1306::begin() for a 128x64 panel on the internal charge
+// pump, horizontal addressing
+static const uint8_t OLED_INIT[] PROGMEM = {
+  SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX, SCREEN_HEIGHT - 1,
+  SSD1306_SETDISPLAYOFFSET, 0x00, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP, 0x14,
+  SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1, SSD1306_COMSCANDEC, SSD1306_SETCOMPINS, 0x12,
+  SSD1306_SETCONTRAST, 0xCF, SSD1306_SETPRECHARGE, 0xF1, SSD1306_SETVCOMDETECT, 0x40,
+  SSD1306_DISPLAYALLON_RESUME, SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON
+};
+
+static uint16_t oledPageHash[OLED_PAGES];
+static bool oledPagesKnown = false;  // false until the first frame has been pushed
+static uint8_t oledFrameCount = 0;
+static uint8_t oledRefreshPage = 0;     // next page to push regardless of its hash
+static uint8_t oledForcePage = 0xFF;    // page pushed regardless of its hash this frame, 0xFF for none
+static unsigned long lastFrameMs = 0;
+static Screen lastFrameScreen = SCREEN_HOME;
 
 void initDisplay() {
   Wire.begin();
-  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
-    Serial.println("### ERRO: OLED nao encontrado");
-    while (true) delay(100);
+  Wire.setClock(OLED_I2C_CLOCK);
+  Wire.beginTransmission(OLED_ADDR);
+  Wire.write((uint8_t)0x00);
+  for (uint8_t i = 0; i < sizeof(OLED_INIT); i++) Wire.write(pgm_read_byte(&OLED_INIT[i]));
+  const uint8_t err = Wire.endTransmission();
+  Wire.setClock(100000UL);
+  if (err != 0) {
+    TxLine(TX_LOG).print(F("### ERRO: OLED nao encontrado\n"));
+    while (true) {
+      txDrain();
+      delay(100);
+    }
   }
 
-  display.clearDisplay();
   display.setTextSize(1);
   display.setTextColor(SSD1306_WHITE);
 
-  display.setCursor(0, 0);
-  display.println("### UI Boot...");
-  display.display();
+  lastFrameMs = millis();
+  display.startPage(0);
+  do {
+    display.println(F("### UI Boot..."));
+  } while (nextPage());
   delay(400);
 }
 
-void drawHeader(const char* title) {
-  display.setCursor(0, 0);
-  display.print(title);
+// Returns false when the frame for this screen is not due yet; otherwise starts at page 0 so the
+// caller can draw. Switching screens always renders immediately, and pushes every page.
+bool beginFrame(Screen screen) {
+  unsigned long now = millis();
+  unsigned long frameMs = (screen == SCREEN_RUNNING) ? OLED_FRAME_MS_RUNNING : OLED_FRAME_MS_MENU;
+  if (oledPagesKnown && screen == lastFrameScreen && (now - lastFrameMs) < frameMs) return false;
+
+  if (screen != lastFrameScreen) oledPagesKnown = false;
+  oledForcePage = 0xFF;
+  if (++oledFrameCount >= OLED_REFRESH_FRAMES) {
+    oledFrameCount = 0;
+    oledForcePage = oledRefreshPage;
+    oledRefreshPage = (uint8_t)((oledRefreshPage + 1) % OLED_PAGES);
+  }
+  lastFrameMs = now;
+  lastFrameScreen = screen;
+  display.startPage(0);
+  return true;
+}
+
+unsigned long frameMillis() {
+  return lastFrameMs;
+}
+
+// h = h * 33 + b over the page: 33 is odd, so any single-byte change always changes the hash.
+// Changes to several bytes can collide (about 1 in 65536 per changed page) and leave a stale page
+// on the panel, so beginFrame() pushes every page on a screen change and one page per
+// OLED_REFRESH_FRAMES frames regardless: a stale page lasts at most 64 frames (~2 s on menus).
+static uint16_t hashPage(const uint8_t* p) {
+  uint16_t h = 5381;
+  for (int i = 0; i < SCREEN_WIDTH; i++) h = (uint16_t)((h << 5) + h + p[i]);
+  return h;
+}
+
+// Dirty pages are streamed: a window is opened at the first one and runs to the last page, so
+// the next page, if it is dirty too, just continues the data (horizontal addressing wraps into it).
+static uint8_t oledStreamPage = 0xFF;  // page the open data stream continues at, 0xFF when closed
+static uint8_t oledStreamBytes = 0;    // bytes in the open Wire transaction
+
+static void oledStreamClose() {
+  if (oledStreamPage == 0xFF) return;
+  Wire.endTransmission();
+  Wire.setClock(100000UL);
+  oledStreamPage = 0xFF;
+}
+
+static void pushPage(uint8_t page, const uint8_t* p) {
+  if (oledStreamPage != page) {
+    oledStreamClose();
+    Wire.setClock(OLED_I2C_CLOCK);
+    Wire.beginTransmission(OLED_ADDR);
+    Wire.write((uint8_t)0x00);
+    Wire.write((uint8_t)SSD1306_PAGEADDR);
+    Wire.write(page);
+    Wire.write((uint8_t)(OLED_PAGES - 1));
+    Wire.write((uint8_t)SSD1306_COLUMNADDR);
+    Wire.write((uint8_t)0);
+    Wire.write((uint8_t)(SCREEN_WIDTH - 1));
+    Wire.endTransmission();
+    Wire.beginTransmission(OLED_ADDR);
+    Wire.write((uint8_t)0x40);
+    oledStreamBytes = 1;
+  }
+  for (uint8_t i = 0; i < SCREEN_WIDTH; i++) {
+    if (oledStreamBytes >= OLED_WIRE_CHUNK) {
+      Wire.endTransmission();
+      Wire.beginTransmission(OLED_ADDR);
+      Wire.write((uint8_t)0x40);
+      oledStreamBytes = 1;
+    }
+    Wire.write(p[i]);
+    oledStreamBytes++;
+  }
+  oledStreamPage = (uint8_t)(page + 1);
+}
+
+// Ends the current page: it goes over I2C only if its content changed since the last frame.
+// Then starts the next one; false once the frame is complete.
+bool nextPage() {
+  const uint8_t page = display.page();
+  const uint16_t h = hashPage(display.pageBuffer());
+  if (!oledPagesKnown || h != oledPageHash[page] || page == oledForcePage) {
+    oledPageHash[page] = h;
+    pushPage(page, display.pageBuffer());
+  } else {
+    oledStreamClose();
+  }
+  if (page + 1 >= OLED_PAGES) {
+    oledStreamClose();
+    oledPagesKnown = true;
+    return false;
+  }
+  display.startPage((uint8_t)(page + 1));
+  return true;
+}
+
+bool displayPageShown(uint8_t page, const uint8_t* panelPage) {
+  return page < OLED_PAGES && hashPage(panelPage) == oledPageHash[page];
+}
+
+// BT badge and rule under a title already printed at (0, 0)
+static void drawHeaderRest() {
   if (getBtConnected()) {
     int cx = SCREEN_WIDTH - 18;
     display.setCursor(cx, 0);
-    display.print("B");
+    display.print('B');
     display.fillTriangle(cx + 8, 0, cx + 14, 0, cx + 11, 4, SSD1306_WHITE);
     display.fillTriangle(cx + 8, 8, cx + 14, 8, cx + 11, 4, SSD1306_WHITE);
   }
@@ -38,11 +253,32 @@ void drawHeader(const char* title) {
   display.drawLine(0, 11, 127, 11, SSD1306_WHITE);
 }
 
-void drawMiniRadar(int x0, int y0, int size, float pan, float tilt) {
-  drawMiniRadarWithLimits(x0, y0, size, pan, tilt, -1.0f, 1.0f, -1.0f, 1.0f);
+void drawHeader(const __FlashStringHelper* title) {
+  display.setCursor(0, 0);
+  display.print(title);
+  drawHeaderRest();
 }
 
-void drawMiniRadarWithLimits(int x0, int y0, int size, float pan, float tilt, float panMin, float panMax, float tiltMin, float tiltMax) {
+void drawHeader(const char* title) {
+  display.setCursor(0, 0);
+  display.print(title);
+  drawHeaderRest();
+}
+
+void drawMarker(bool selected) {
+  display.print(selected ? F("> ") : F("  "));
+}
+
+void drawMiniRadar(int x0, int y0, int size, q16_t pan, q16_t tilt) {
+  drawMiniRadarWithLimits(x0, y0, size, pan, tilt, -Q16_ONE, Q16_ONE, -Q16_ONE, Q16_ONE);
+}
+
+// Q16 span (0..2.0) -> pixels of a box `size` wide (span * size / 2), rounded
+static int radarSpanPx(q16_t span, int size) {
+  return (int)((span * (int32_t)size + Q16_ONE) >> 17);
+}
+
+void drawMiniRadarWithLimits(int x0, int y0, int size, q16_t pan, q16_t tilt, q16_t panMin, q16_t panMax, q16_t tiltMin, q16_t tiltMax) {
   int cx = x0 + size / 2;
   int cy = y0 + size / 2;
   int radius = size / 2;
@@ -53,10 +289,10 @@ void drawMiniRadarWithLimits(int x0, int y0, int size, float pan, float tilt, fl
   }
 
   if (panMin < panMax && tiltMin < tiltMax) {
-    int rx = x0 + (int)((panMin + 1.0f) * 0.5f * (float)size + 0.5f);
-    int ry = y0 + (int)((tiltMin + 1.0f) * 0.5f * (float)size + 0.5f);
-    int rw = (int)((panMax - panMin) * 0.5f * (float)size + 0.5f);
-    int rh = (int)((tiltMax - tiltMin) * 0.5f * (float)size + 0.5f);
+    int rx = x0 + radarSpanPx(panMin + Q16_ONE, size);
+    int ry = y0 + radarSpanPx(tiltMin + Q16_ONE, size);
+    int rw = radarSpanPx(panMax - panMin, size);
+    int rh = radarSpanPx(tiltMax - tiltMin, size);
     if (rw > 0 && rh > 0) {
       if (rw >= 3 && rh >= 3) {
         display.fillRect(rx + 1, ry + 1, rw - 2, rh - 2, SSD1306_BLACK);
@@ -69,8 +305,8 @@ void drawMiniRadarWithLimits(int x0, int y0, int size, float pan, float tilt, fl
   display.drawLine(cx - 2, cy, cx + 2, cy, SSD1306_WHITE);
   display.drawLine(cx, cy - 2, cx, cy + 2, SSD1306_WHITE);
 
-  int px = cx + (int)(pan * (float)radius + 0.5f);
-  int py = cy + (int)(tilt * (float)radius + 0.5f);
+  int px = cx + (int)((pan * (int32_t)radius + Q16_HALF) >> 16);
+  int py = cy + (int)((tilt * (int32_t)radius + Q16_HALF) >> 16);
   display.fillCircle(px, py, 2, SSD1306_WHITE);
 }
 
@@ -129,7 +365,7 @@ static int feederPixelOnAt(unsigned long col, unsigned long onMs, unsigned long
 #define FEEDER_GRAPH_BAR_W  32
 #define FEEDER_GRAPH_BAR_H  4
 
-void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs) {
+void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned long onMs, unsigned long offMs) {
   if (w <= 0 || h <= 0) return;
 
   // Borda ao redor do gráfico (1 px)
@@ -145,14 +381,8 @@ void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned
     int fillCol;
     if (mode == FEED_CONTINUOUS) {
       fillCol = 1;
-    } else if (mode == FEED_PULSE_1_1) {
-      fillCol = feederPixelOnAt((unsigned long)col, 1000UL, 1000UL);
-    } else if (mode == FEED_PULSE_2_1) {
-      fillCol = feederPixelOnAt((unsigned long)col, 2000UL, 1000UL);
-    } else if (mode == FEED_PULSE_2_2) {
-      fillCol = feederPixelOnAt((unsigned long)col, 2000UL, 2000UL);
     } else {
-      fillCol = feederPixelOnAt((unsigned long)col, customOnMs, customOffMs);
+      fillCol = feederPixelOnAt((unsigned long)col, onMs, offMs);
     }
 
     if (fillCol) {
@@ -162,44 +392,14 @@ void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned
 }
 
 // Rotor (hélices) do feeder: 3 blades, sincronizado com fase on/off, sentido horário.
-// Calibração a 7,5 V (modo contínuo): 70→4,50s, 160→2,91s, 255→2,60s.
-#define FEEDER_ROTOR_BLADES 3
-#define FEEDER_T_SEC_AT_70  4.50f
-#define FEEDER_T_SEC_AT_160 2.91f
-#define FEEDER_T_SEC_AT_255 2.60f
-
-// Segundos por volta para um dado speed (0–255), interpolação linear entre os 3 pontos.
-static float feederSecondsPerRotation(int speed) {
-  if (speed <= 0) return 6.0f;
-  if (speed <= 70) {
-    float t = FEEDER_T_SEC_AT_70 + (70 - speed) / 70.0f * (6.0f - FEEDER_T_SEC_AT_70);
-    if (t > 6.0f) t = 6.0f;
-    if (t < FEEDER_T_SEC_AT_70) t = FEEDER_T_SEC_AT_70;
-    return t;
-  }
-  if (speed <= 160) {
-    return FEEDER_T_SEC_AT_70 - (FEEDER_T_SEC_AT_70 - FEEDER_T_SEC_AT_160) / (160.0f - 70.0f) * (float)(speed - 70);
-  }
-  if (speed <= 255) {
-    float t = FEEDER_T_SEC_AT_160 - (FEEDER_T_SEC_AT_160 - FEEDER_T_SEC_AT_255) / (255.0f - 160.0f) * (float)(speed - 160);
-    if (t < FEEDER_T_SEC_AT_255) t = FEEDER_T_SEC_AT_255;
-    if (t > FEEDER_T_SEC_AT_160) t = FEEDER_T_SEC_AT_160;
-    return t;
-  }
-  return FEEDER_T_SEC_AT_255;
-}
+// Velocidade pela calibração de feederMsPerRotation() (motors.h).
+#define FEEDER_ROTOR_BLADES FEEDER_DISC_HOLES
 
 // Tempo acumulado em fase "on" (ms); em off o valor fica congelado.
-static unsigned long feederRotorAccumulatedOnMs(FeederMode mode, unsigned long customOnMs, unsigned long customOffMs) {
-  unsigned long now = millis();
+static unsigned long feederRotorAccumulatedOnMs(FeederMode mode, unsigned long onMs, unsigned long offMs) {
+  unsigned long now = frameMillis();
   if (mode == FEED_CONTINUOUS) return now;
 
-  unsigned long onMs = customOnMs;
-  unsigned long offMs = customOffMs;
-  if (mode == FEED_PULSE_1_1) { onMs = 1000UL; offMs = 1000UL; }
-  else if (mode == FEED_PULSE_2_1) { onMs = 2000UL; offMs = 1000UL; }
-  else if (mode == FEED_PULSE_2_2) { onMs = 2000UL; offMs = 2000UL; }
-
   unsigned long total = onMs + offMs;
   if (total == 0) total = 1;
   unsigned long fullCycles = now / total;
@@ -216,7 +416,7 @@ static unsigned long feederRotorAccumulatedOnMs(FeederMode mode, unsigned long c
 static float feederRotorLastAngle = 0.0f;
 static unsigned long feederRotorPrevAccumulatedOn = 0xFFFFFFFFUL;
 
-void drawFeederRotor(int x0, int y0, int size, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs, int feederSpeed) {
+void drawFeederRotor(int x0, int y0, int size, FeederMode mode, unsigned long onMs, unsigned long offMs, int feederSpeed) {
   if (size < 6) return;
 
   int cx = x0 + size / 2;
@@ -224,10 +424,9 @@ void drawFeederRotor(int x0, int y0, int size, FeederMode mode, unsigned long cu
   int radius = size / 2 - 2;
   if (radius < 2) radius = 2;
 
-  float tSec = feederSecondsPerRotation(feederSpeed);
-  float degPerMs = 360.0f / (tSec * 1000.0f);
+  float degPerMs = 360.0f / (float)feederMsPerRotation(feederSpeed);
 
-  unsigned long accumulatedOn = feederRotorAccumulatedOnMs(mode, customOnMs, customOffMs);
+  unsigned long accumulatedOn = feederRotorAccumulatedOnMs(mode, onMs, offMs);
 
   if (feederRotorPrevAccumulatedOn == 0xFFFFFFFFUL) {
     feederRotorLastAngle = (float)(accumulatedOn % 360000UL) * degPerMs;
@@ -5,14 +5,50 @@
 #include <Adafruit_SSD1306.h>
 #include "config.h"
 
+// GFX target for one 8-row page of the panel (128 bytes) instead of the library's 1 KB
+// framebuffer. A frame is drawn once per page, u8g2-style:
+//   if (!beginFrame(screen)) return;
+//   do { ...draw the whole screen... } while (nextPage());
+// Primitives clip to the current page, so drawing outside it costs little more than the call.
+// Only rotation 0 and the built-in 6x8 font are supported.
+class OledPager : public Adafruit_GFX {
+public:
+  OledPager() : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT), page_(0) {}
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  void startPage(uint8_t page);  // clears the buffer and resets the text cursor
+  uint8_t page() const { return page_; }
+  const uint8_t* pageBuffer() const { return buf_; }
+
+private:
+  void fillColumns(int16_t x, int16_t w, uint8_t mask, uint16_t color);
+
+  uint8_t page_;
+  uint8_t buf_[SCREEN_WIDTH];
+};
+
 void initDisplay();
-void drawHeader(const char* title);
-void drawMiniRadar(int x0, int y0, int size, float pan, float tilt);
-void drawMiniRadarWithLimits(int x0, int y0, int size, float pan, float tilt, float panMin, float panMax, float tiltMin, float tiltMax);
+bool beginFrame(Screen screen);  // false when the frame for this screen is not due yet
+bool nextPage();                 // sends the page if it changed; false after the last one
+unsigned long frameMillis();     // millis() at beginFrame: every page of a frame draws the same
+bool displayPageShown(uint8_t page, const uint8_t* panelPage);  // simulator: panel page == last frame
+void drawHeader(const __FlashStringHelper* title);  // static titles: drawHeader(F("HOME"))
+void drawHeader(const char* title);                 // titles built at run time
+void drawMarker(bool selected);                     // "> " or "  " at the start of a menu line
+void drawMiniRadar(int x0, int y0, int size, q16_t pan, q16_t tilt);
+void drawMiniRadarWithLimits(int x0, int y0, int size, q16_t pan, q16_t tilt, q16_t panMin, q16_t panMax, q16_t tiltMin, q16_t tiltMax);
 void drawSpinVisualizer(int x0, int y0, int size, SpinMode spinMode);
-void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs);
-void drawFeederRotor(int x0, int y0, int size, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs, int feederSpeed);
+// onMs/offMs as resolved by feederPulseTiming() (motors.h)
+void drawFeederModeGraph(int x0, int y0, int w, int h, FeederMode mode, unsigned long onMs, unsigned long offMs);
+void drawFeederRotor(int x0, int y0, int size, FeederMode mode, unsigned long onMs, unsigned long offMs, int feederSpeed);
 
-extern Adafruit_SSD1306 display;
+extern OledPager display;
 
 #endif
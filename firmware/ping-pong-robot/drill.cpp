@@ -0,0 +1,105 @@
+#include "drill.h"
+#include "bt_command.h"
+#include "logic.h"
+#include "motors.h"
+#include "shot.h"
+
+struct DrillStep {
+  DrillEnd end;
+  uint16_t amount;  // seconds or balls
+  uint8_t fieldCount;
+  uint8_t ids[DRILL_MAX_FIELDS];
+  int values[DRILL_MAX_FIELDS];
+};
+
+static DrillStep drillSteps[DRILL_MAX_STEPS];
+static uint8_t drillCount = 0;
+
+static Config drillBase;           // cfg when the run started
+static bool drillBaseSaved = false;
+static uint8_t drillIndex = 0;     // 0-based step while running
+static unsigned long drillStepStartMs = 0;
+static int drillStepStartShots = 0;
+
+bool drillSetStep(uint8_t step, DrillEnd end, uint16_t amount, const uint8_t* ids, const int* values, uint8_t n) {
+  if (drillBaseSaved) return false;
+  if (step == 0 || step > DRILL_MAX_STEPS || step > drillCount + 1) return false;
+  if (end >= DRILL_END_COUNT || n > DRILL_MAX_FIELDS) return false;
+  if (amount > INT16_MAX) return false;  // ball steps compare against int counts (16-bit on the Mega)
+  DrillStep &s = drillSteps[step - 1];
+  s.end = end;
+  s.amount = amount;
+  s.fieldCount = n;
+  for (uint8_t i = 0; i < n; i++) {
+    s.ids[i] = ids[i];
+    s.values[i] = values[i];
+  }
+  drillCount = step;
+  return true;
+}
+
+bool drillClear() {
+  if (drillBaseSaved) return false;
+  drillCount = 0;
+  return true;
+}
+
+uint8_t drillStepCount() {
+  return drillCount;
+}
+
+static void enterStep(uint8_t i) {
+  drillIndex = i;
+  drillStepStartMs = millis();
+  drillStepStartShots = feederBallCount();
+
+  cfg = drillBase;
+  const DrillStep &s = drillSteps[i];
+  bool aimTouched = false;
+  for (uint8_t f = 0; f < s.fieldCount; f++) {
+    applyConfigField(s.ids[f], s.values[f]);
+    if (s.ids[f] == 2 || s.ids[f] == 3) aimTouched = true;
+  }
+  // A step that places the ball starts from its targets; otherwise the aim carries on from where it is
+  if (aimTouched) {
+    livePan = cfg.panTarget;
+    liveTilt = cfg.tiltTarget;
+  }
+}
+
+void drillStart() {
+  if (drillCount == 0) return;
+  if (!drillBaseSaved) drillBase = cfg;  // restart without a stop in between keeps the first base
+  drillBaseSaved = true;
+  enterStep(0);
+}
+
+static bool stepDone(const DrillStep &s) {
+  switch (s.end) {
+    case DRILL_END_SECONDS:
+      return (millis() - drillStepStartMs) >= (unsigned long)s.amount * 1000UL;
+    case DRILL_END_BALLS:
+      // Without the exit sensor the count goes up when a feed starts; the step ends once that ball is out
+      return (feederBallCount() - drillStepStartShots) >= (int)s.amount && !shotHolding();
+    default:
+      return false;
+  }
+}
+
+bool drillTick() {
+  if (!drillBaseSaved) return true;
+  if (!stepDone(drillSteps[drillIndex])) return true;
+  if (drillIndex + 1 >= drillCount) return false;
+  enterStep(drillIndex + 1);
+  return true;
+}
+
+void drillRestore() {
+  if (!drillBaseSaved) return;
+  cfg = drillBase;
+  drillBaseSaved = false;
+}
+
+uint8_t drillCurrentStep() {
+  return drillBaseSaved ? (uint8_t)(drillIndex + 1) : 0;
+}
@@ -0,0 +1,41 @@
+#ifndef DRILL_H
+#define DRILL_H
+
+#include <Arduino.h>
+
+// Drill program: an ordered list of steps, each a partial Config override (field ids in <C,...>
+// order, same clamps as a delta config) that lasts a number of seconds or balls. The program stays
+// loaded until Q,0 but only runs for starts from the app (S or a start frame); a run started from
+// the OLED wizard uses the menu settings as they are. On an app start, startRunning() snapshots
+// cfg as the base and enters step 1; each step starts from the base plus its own overrides. Steps
+// change on the control tick without stopping the motors (the motor caches only write speeds that
+// changed). A last step with DRILL_END_HOLD keeps running until stop or the timer; any other last
+// step ends the run when it completes. The base config is restored when the run stops. Ball counts
+// use feederBallCount(): exit-sensor balls if fitted, else feeder pulses, which need a pulsed
+// feeder mode (continuous feeding is one long pulse); a ball step ends when its last feed phase
+// does.
+
+#define DRILL_MAX_STEPS  8
+#define DRILL_MAX_FIELDS 8  // overrides per step
+
+enum DrillEnd : uint8_t {
+  DRILL_END_HOLD = 0,  // until stop / timer
+  DRILL_END_SECONDS,
+  DRILL_END_BALLS,
+  DRILL_END_COUNT
+};
+
+// Stores step `step` (1-based). Steps are uploaded in order: step 1 starts a new program and step
+// n drops any steps after it. Returns false (nothing stored) if the step does not follow the
+// program, has too many fields, an amount above INT16_MAX, or a drill is running; ids must already
+// be < BT_CONFIG_FIELDS. Config writes from the app (C, U, L) are refused while a drill runs.
+bool drillSetStep(uint8_t step, DrillEnd end, uint16_t amount, const uint8_t* ids, const int* values, uint8_t n);
+bool drillClear();  // false while a drill is running
+uint8_t drillStepCount();
+
+void drillStart();    // from startRunning() for app starts, before cfg is used
+bool drillTick();     // every running control tick; false when the last step has completed
+void drillRestore();  // every stopped control tick; puts the base config back once
+uint8_t drillCurrentStep();  // 1-based while a drill runs, 0 otherwise
+
+#endif
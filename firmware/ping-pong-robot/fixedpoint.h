@@ -0,0 +1,42 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <stdint.h>
+
+// Q16.16 fixed point for the aim path: joystick -> LIVE/AUTO/RANDOM -> servo angle.
+// Normalized aim -1..+1 is -Q16_ONE..+Q16_ONE. Only fixed-width integer math, so the
+// simulator (host) and the Mega compute the same bits, and the control tick runs no
+// software float routines. float is left for UI text only (q16ToFloat).
+typedef int32_t q16_t;
+
+#define Q16_ONE  65536L
+#define Q16_HALF 32768L
+
+// Literal -> Q16 at compile time, e.g. Q16(0.035). Not meant for runtime values. avr-gcc folds
+// this in 32-bit double, so keep x * 65536 clear of .5 boundaries for host/target to agree.
+constexpr q16_t Q16(double x) { return (q16_t)(x * 65536.0 + (x >= 0.0 ? 0.5 : -0.5)); }
+
+// Product rounded toward -inf (arithmetic shift); 32x32->64 widening multiply.
+inline q16_t q16Mul(q16_t a, q16_t b) { return (q16_t)(((int64_t)a * (int64_t)b) >> 16); }
+
+inline q16_t q16Abs(q16_t v) { return v < 0 ? -v : v; }
+
+inline q16_t q16Clamp(q16_t v, q16_t lo, q16_t hi) {
+  if (v < lo) return lo;
+  if (v > hi) return hi;
+  return v;
+}
+
+// App protocol carries aim values as value*1000; round half away from zero both ways.
+inline q16_t q16FromMilli(int32_t milli) {
+  return (milli * Q16_ONE + (milli >= 0 ? 500L : -500L)) / 1000L;
+}
+
+inline int32_t q16ToMilli(q16_t q) {
+  int32_t m = q * 1000L;
+  return (m + (m >= 0 ? Q16_HALF : -Q16_HALF)) / Q16_ONE;
+}
+
+inline float q16ToFloat(q16_t q) { return (float)q / 65536.0f; }
+
+#endif
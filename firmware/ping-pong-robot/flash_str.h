@@ -0,0 +1,20 @@
+#ifndef FLASH_STR_H
+#define FLASH_STR_H
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Static UI text stays in flash. On the Mega a plain string literal is copied into SRAM at boot;
+// F("...") and PROGMEM strings are not. A single string is F() at the call site; a list (menu
+// items, mode names) is a PROGMEM table of PROGMEM strings:
+//   static const char HOME_WIZARD[] PROGMEM = "Start Wizard";
+//   static const char* const HOME_ITEMS[] PROGMEM = { HOME_WIZARD, ... };
+// flashStr() reads one entry back as a __FlashStringHelper, so Print takes its flash overload.
+
+#define FLASH_STR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+
+inline const __FlashStringHelper* flashStr(const char* const* table, uint8_t i) {
+  return FLASH_STR(pgm_read_ptr(&table[i]));
+}
+
+#endif
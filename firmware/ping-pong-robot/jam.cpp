@@ -0,0 +1,92 @@
+#include "jam.h"
+#include "config.h"
+
+uint16_t jamCount = 0;
+uint16_t ballsOut = 0;
+
+#if FEEDER_EXIT_SENSOR
+
+enum JamState : uint8_t { JAM_WATCH, JAM_REVERSE, JAM_FORWARD, JAM_GAVE_UP };
+
+static JamState jamState = JAM_WATCH;
+static unsigned long jamLastMs = 0;
+static unsigned long jamFeedMs = 0;    // feeding time since the last ball
+static unsigned long jamPhaseMs = 0;   // start of the reverse / forward phase
+static uint8_t jamRetries = 0;
+static bool exitBlocked = false;
+static bool ballSeen = false;
+
+void initJamSensor() {
+  pinMode(FEEDER_EXIT_PIN, INPUT_PULLUP);
+}
+
+void jamReset() {
+  jamState = JAM_WATCH;
+  jamCount = 0;
+  ballsOut = 0;
+  ballSeen = false;
+  jamRetries = 0;
+  jamFeedMs = 0;
+  jamLastMs = millis();
+  exitBlocked = digitalRead(FEEDER_EXIT_PIN) == LOW;
+}
+
+int8_t jamUpdate(unsigned long now, bool feeding, unsigned long ballMs) {
+  const unsigned long dt = now - jamLastMs;
+  jamLastMs = now;
+
+  // A ball reaching the beam clears the jam timer
+  const bool blocked = digitalRead(FEEDER_EXIT_PIN) == LOW;
+  ballSeen = blocked && !exitBlocked;
+  if (ballSeen) {
+    ballsOut++;
+    jamFeedMs = 0;
+    jamRetries = 0;
+  }
+  exitBlocked = blocked;
+
+  switch (jamState) {
+    case JAM_WATCH:
+      if (!feeding) return 0;
+      jamFeedMs += dt;
+      if (jamFeedMs < FEEDER_JAM_MS || jamFeedMs < FEEDER_JAM_BALLS * ballMs) return 0;
+      jamCount++;
+      jamFeedMs = 0;
+      if (++jamRetries > FEEDER_JAM_MAX_RETRIES) {
+        jamState = JAM_GAVE_UP;
+        return 0;
+      }
+      jamState = JAM_REVERSE;
+      jamPhaseMs = now;
+      return -1;
+    case JAM_REVERSE:
+      if (now - jamPhaseMs < FEEDER_UNJAM_REVERSE_MS) return -1;
+      jamState = JAM_FORWARD;
+      jamPhaseMs = now;
+      return 1;
+    case JAM_FORWARD:
+      if (now - jamPhaseMs < FEEDER_UNJAM_FORWARD_MS) return 1;
+      jamState = JAM_WATCH;
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+bool jamGaveUp() {
+  return jamState == JAM_GAVE_UP;
+}
+
+bool jamBallSeen() {
+  return ballSeen;
+}
+
+#else
+
+void initJamSensor() {}
+void jamReset() {}
+int8_t jamUpdate(unsigned long now, bool feeding, unsigned long ballMs) { return 0; }
+bool jamGaveUp() { return false; }
+bool jamBallSeen() { return false; }
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef JAM_H
+#define JAM_H
+
+#include <Arduino.h>
+
+// Feeder jam detection. While M4 feeds forward, the ball-exit sensor (FEEDER_EXIT_PIN) must see a
+// ball within FEEDER_JAM_MS of feeding time, or FEEDER_JAM_BALLS ball intervals when the disc turns
+// slower than that (below ~150 PWM, feederMsPerRotation()); otherwise the feeder is jammed and an un-jam cycle
+// runs: FEEDER_UNJAM_REVERSE_MS in reverse, FEEDER_UNJAM_FORWARD_MS forward at full speed, then
+// normal feeding resumes. After FEEDER_JAM_MAX_RETRIES cycles in a row with no ball the hopper is
+// empty or the jam is hard, and the run stops. Compiled out unless FEEDER_EXIT_SENSOR is set.
+
+void initJamSensor();
+void jamReset();  // from startRunning()
+// From updateFeederMotor() once the pullback is over; feeding = M4 has been pushing forward,
+// ballMs = feeding time per ball at the current speed. Returns the un-jam drive while a cycle
+// runs (-1 reverse, +1 forward), 0 for normal feeding.
+int8_t jamUpdate(unsigned long now, bool feeding, unsigned long ballMs);
+bool jamGaveUp();  // retries exhausted: the run should stop
+bool jamBallSeen();  // a ball reached the exit sensor on the last jamUpdate()
+
+extern uint16_t jamCount;  // jams detected this run
+extern uint16_t ballsOut;  // balls seen by the exit sensor this run
+
+#endif
@@ -4,16 +4,15 @@
 #include "servos.h"
 #include "motors.h"
 #include "bt_command.h"
+#include "drill.h"
+#include "jam.h"
+#include "shot.h"
+#include "profiles.h"
 #include <Arduino.h>
 
-// Forward declaration para acessar os motores diretamente
-extern AF_DCMotor motor1;
-extern AF_DCMotor motor2;
-extern AF_DCMotor motor3;
-
 // ================= Auto state vars =================
-float panDir = 1.0f;
-float tiltDir = 1.0f;
+int8_t panDir = 1;
+int8_t tiltDir = 1;
 unsigned long panLastStepMs = 0;
 unsigned long tiltLastStepMs = 0;
 
@@ -22,8 +21,8 @@ const unsigned long AUTO2_PAUSE_MS = 1000;
 // ================= Globals =================
 Screen currentScreen = SCREEN_HOME;
 
-float livePan = 0.0f;
-float liveTilt = 0.0f;
+q16_t livePan = 0;
+q16_t liveTilt = 0;
 
 bool isRunning = false;
 unsigned long runStartMs = 0;
@@ -40,6 +39,8 @@ int launcherIndex = 0;
 int spinIndex = 0;
 int feederIndex = 0;
 int timerMenuIndex = 0;
+int profileMenuIndex = 1;
+bool profileSaveMode = false;
 int settingsIndex = 0;  // 0=Servo1, 1=Servo2, 2=M1, 3=M2, 4=M3, 5=M4, 6=Back
 int settingsServoEditIndex = 0;  // 0: MIN, 1: MID, 2: MAX, 3: Back
 int settingsServoSelected = 0;  // 0: Servo 1 (TILT), 1: Servo 2 (PAN)
@@ -51,38 +52,39 @@ bool settingsMotorM4Revert = false;
 Config cfg;
 
 // ================= Auto update =================
-float auto1Update(float base, float &dir, float speed, float minVal, float maxVal) {
-  base += dir * speed;
-  if (base >= maxVal) { base = maxVal; dir = -1.0f; }
-  if (base <= minVal) { base = minVal; dir = 1.0f; }
+q16_t auto1Update(q16_t base, int8_t &dir, q16_t speed, q16_t minVal, q16_t maxVal) {
+  base += (dir > 0) ? speed : -speed;
+  if (base >= maxVal) { base = maxVal; dir = -1; }
+  if (base <= minVal) { base = minVal; dir = 1; }
   return base;
 }
 
-float auto2Update(float base, float &dir, unsigned long &lastStepMs, float step, unsigned long pauseMs, float minVal, float maxVal) {
+q16_t auto2Update(q16_t base, int8_t &dir, unsigned long &lastStepMs, q16_t step, unsigned long pauseMs, q16_t minVal, q16_t maxVal) {
   unsigned long now = millis();
   if (now - lastStepMs < pauseMs) return base;
 
   lastStepMs = now;
-  base += dir * step;
+  base += (dir > 0) ? step : -step;
 
-  if (base >= maxVal) { base = maxVal; dir = -1.0f; }
-  if (base <= minVal) { base = minVal; dir = 1.0f; }
+  if (base >= maxVal) { base = maxVal; dir = -1; }
+  if (base <= minVal) { base = minVal; dir = 1; }
 
   return base;
 }
 
-static float pickRandomTarget(float minVal, float maxVal, float current, float minDist) {
-  float range = maxVal - minVal;
-  if (range <= 0.0f) return current;
+static q16_t pickRandomTarget(q16_t minVal, q16_t maxVal, q16_t current, q16_t minDist) {
+  q16_t range = maxVal - minVal;
+  if (range <= 0) return current;
   for (int attempt = 0; attempt < 20; attempt++) {
-    float t = minVal + (float)(random(0, 10001) / 10000.0) * range;
-    if (fabs(t - current) >= minDist) return t;
+    // range <= 2.0 (131072) * 10000 fits in int32
+    q16_t t = minVal + (q16_t)(range * (int32_t)random(0, 10001) / 10000L);
+    if (q16Abs(t - current) >= minDist) return t;
   }
-  return current + (current < (minVal + maxVal) * 0.5f ? minDist : -minDist);
+  return current + (current < (minVal + maxVal) / 2 ? minDist : -minDist);
 }
 
-void applyAuto(float &value, AxisMode mode, float &dir, unsigned long &lastStepMs, float auto1Speed, float auto2Step,
-               unsigned long auto2PauseMs, float minVal, float maxVal, unsigned long randomPauseMs, float randomMinDist) {
+void applyAuto(q16_t &value, AxisMode mode, int8_t &dir, unsigned long &lastStepMs, q16_t auto1Speed, q16_t auto2Step,
+               unsigned long auto2PauseMs, q16_t minVal, q16_t maxVal, unsigned long randomPauseMs, q16_t randomMinDist) {
   if (mode == AXIS_AUTO1) {
     value = auto1Update(value, dir, auto1Speed, minVal, maxVal);
   } else if (mode == AXIS_AUTO2) {
@@ -98,35 +100,43 @@ void applyAuto(float &value, AxisMode mode, float &dir, unsigned long &lastStepM
 
 // ================= Logic updates =================
 void updateRunningLogic() {
-  if (!isRunning) return;
+  if (!isRunning) {
+    drillRestore();
+    return;
+  }
 
   unsigned long played = millis() - runStartMs;
   if (played > maxPlayedMs) maxPlayedMs = played;
 
+  // Timer elapsed, ball limit reached (once the last ball is out), the last step of a drill
+  // program completed, or the feeder stayed jammed
   unsigned long tms = timerMsByIndex(cfg.timerIndex);
-  if (tms > 0 && millis() - runStartMs >= tms) {
+  bool ballsDone = cfg.ballLimit > 0 && feederBallCount() >= cfg.ballLimit && !shotHolding();
+  if ((tms > 0 && millis() - runStartMs >= tms) || ballsDone || !drillTick() || jamGaveUp()) {
     isRunning = false;
     stopAllMotors();
     currentScreen = SCREEN_HOME;
     return;
   }
 
-  float stickX = 0.0f, stickY = 0.0f;
+  q16_t stickX = 0, stickY = 0;
+  // AUTO2/RANDOM steps wait while a ball is being fed; their pause runs from the last step taken
+  const bool stepsHeld = shotHolding();
   // PAN
   if (cfg.panMode == AXIS_LIVE) {
     stickX = joyToNorm(analogRead(JOY_X));
-    applyIncremental(livePan, stickX);
-  } else {
-    applyAuto(livePan, cfg.panMode, panDir, panLastStepMs, cfg.panAuto1Speed, cfg.panAuto2Step, cfg.panAuto2PauseMs,
+    applyIncremental(livePan, stickX, CONTROL_TICK_SCALE(AIM_STEP));
+  } else if (!stepsHeld || cfg.panMode == AXIS_AUTO1) {
+    applyAuto(livePan, cfg.panMode, panDir, panLastStepMs, CONTROL_TICK_SCALE(cfg.panAuto1Speed), cfg.panAuto2Step, cfg.panAuto2PauseMs,
               cfg.panMin, cfg.panMax, cfg.panRandomPauseMs, cfg.panRandomMinDist);
   }
 
   // TILT
   if (cfg.tiltMode == AXIS_LIVE) {
     stickY = joyToNorm(analogRead(JOY_Y));
-    applyIncremental(liveTilt, stickY);
-  } else {
-    applyAuto(liveTilt, cfg.tiltMode, tiltDir, tiltLastStepMs, cfg.tiltAuto1Speed, cfg.tiltAuto2Step, cfg.tiltAuto2PauseMs,
+    applyIncremental(liveTilt, stickY, CONTROL_TICK_SCALE(AIM_STEP));
+  } else if (!stepsHeld || cfg.tiltMode == AXIS_AUTO1) {
+    applyAuto(liveTilt, cfg.tiltMode, tiltDir, tiltLastStepMs, CONTROL_TICK_SCALE(cfg.tiltAuto1Speed), cfg.tiltAuto2Step, cfg.tiltAuto2PauseMs,
               cfg.tiltMin, cfg.tiltMax, cfg.tiltRandomPauseMs, cfg.tiltRandomMinDist);
   }
 
@@ -134,8 +144,8 @@ void updateRunningLogic() {
     static unsigned long lastStickActiveMs = 0;
     static bool liveAimSentSinceRelease = false;
     const unsigned long now = millis();
-    const float dead = 0.05f;
-    if (fabs(stickX) >= dead || fabs(stickY) >= dead) {
+    const q16_t dead = Q16(0.05);
+    if (q16Abs(stickX) >= dead || q16Abs(stickY) >= dead) {
       lastStickActiveMs = now;
       liveAimSentSinceRelease = false;
     } else if (lastStickActiveMs != 0 && (now - lastStickActiveMs) >= 300 && !liveAimSentSinceRelease) {
@@ -144,25 +154,28 @@ void updateRunningLogic() {
     }
   }
 
-  // Atualizar servos com os valores normalizados
-  updateServos(livePan, liveTilt);
-
-  // Atualizar motores do launcher (M1, M2, M3)
-  updateLauncherMotors(cfg.launcherPower, cfg.spinMode, cfg.spinIntensity);
-
-  // Atualizar motor feeder (M4); runStartMs usado para recuada inicial de 0,5 s
-  updateFeederMotor(cfg.feederSpeed, cfg.feederMode, cfg.feederCustomOnMs, cfg.feederCustomOffMs, runStartMs);
+  // Servos, launcher (M1, M2, M3) and feeder (M4), synced per ball
+  shotTick(livePan, liveTilt);
 }
 
 void updateAxisPreviewTargets() {
   if (currentScreen == SCREEN_PAN) {
-    applyAuto(cfg.panTarget, cfg.panMode, panDir, panLastStepMs, cfg.panAuto1Speed, cfg.panAuto2Step, cfg.panAuto2PauseMs,
+    applyAuto(cfg.panTarget, cfg.panMode, panDir, panLastStepMs, CONTROL_TICK_SCALE(cfg.panAuto1Speed), cfg.panAuto2Step, cfg.panAuto2PauseMs,
               cfg.panMin, cfg.panMax, cfg.panRandomPauseMs, cfg.panRandomMinDist);
   }
   if (currentScreen == SCREEN_TILT) {
-    applyAuto(cfg.tiltTarget, cfg.tiltMode, tiltDir, tiltLastStepMs, cfg.tiltAuto1Speed, cfg.tiltAuto2Step, cfg.tiltAuto2PauseMs,
+    applyAuto(cfg.tiltTarget, cfg.tiltMode, tiltDir, tiltLastStepMs, CONTROL_TICK_SCALE(cfg.tiltAuto1Speed), cfg.tiltAuto2Step, cfg.tiltAuto2PauseMs,
               cfg.tiltMin, cfg.tiltMax, cfg.tiltRandomPauseMs, cfg.tiltRandomMinDist);
   }
+  // Edição do alvo com o joystick; servos acompanham em tempo real
+  if (currentScreen == SCREEN_PAN_EDIT) {
+    applyIncremental(cfg.panTarget, joyToNorm(analogRead(JOY_X)), CONTROL_TICK_SCALE(AIM_STEP));
+    updateServos(cfg.panTarget, cfg.tiltTarget);
+  }
+  if (currentScreen == SCREEN_TILT_EDIT) {
+    applyIncremental(cfg.tiltTarget, joyToNorm(analogRead(JOY_Y)), CONTROL_TICK_SCALE(AIM_STEP));
+    updateServos(cfg.panTarget, cfg.tiltTarget);
+  }
 }
 
 // ================= Flow helpers =================
@@ -176,34 +189,22 @@ void cancelToHome() {
   currentScreen = SCREEN_HOME;
 }
 
-void startRunning() {
+void startRunning(bool runDrill) {
   isRunning = true;
   runStartMs = millis();
+  feederPulseCount = 0;
+  jamReset();
+  profileAutosave();  // before the drill's overrides touch cfg
+  if (runDrill) drillStart();  // first step's overrides go into cfg before anything below reads it
 
   livePan = cfg.panTarget;
   liveTilt = cfg.tiltTarget;
+  shotStart();
 
-  // Inicia os motores gradualmente para evitar pico de corrente
-  // Primeiro inicia com velocidade baixa (metade da velocidade configurada)
-  int initialSpeed = cfg.launcherPower / 2;
-  if (initialSpeed < 50) initialSpeed = 50; // Mínimo de 50 para garantir que gire
-  
-  // Reseta cache e inicia com velocidade reduzida
+  // Launchers ramp up from 0 on the control tick (updateLauncherMotors)
   resetMotorCache();
-  
-  motor1.setSpeed(initialSpeed);
-  motor2.setSpeed(initialSpeed);
-  motor3.setSpeed(initialSpeed);
-  motor1.run(FORWARD);
-  motor2.run(FORWARD);
-  motor3.run(FORWARD);
-  
-  // Atualiza cache manualmente (sem spin no início)
-  setMotorCache(initialSpeed, initialSpeed, initialSpeed);
 
   currentScreen = SCREEN_RUNNING;
-  
-  // A velocidade completa será aplicada no próximo loop através de updateRunningLogic()
 }
 
 // ================= Axis menu helpers =================
@@ -217,10 +218,17 @@ bool axisHasSecondOption(AxisMode mode) {
   return (mode == AXIS_LIVE || mode == AXIS_AUTO1 || mode == AXIS_AUTO2 || mode == AXIS_RANDOM);
 }
 
-const char* axisSecondLabel(AxisMode mode) {
-  if (mode == AXIS_LIVE) return "Edit Target";
-  if (mode == AXIS_AUTO1) return "Speed";
-  if (mode == AXIS_AUTO2) return "Step";
-  if (mode == AXIS_RANDOM) return "Min";
-  return "";
+const __FlashStringHelper* axisSecondLabel(AxisMode mode) {
+  if (mode == AXIS_LIVE) return F("Edit Target");
+  if (mode == AXIS_AUTO1) return F("Speed");
+  if (mode == AXIS_AUTO2) return F("Step");
+  if (mode == AXIS_RANDOM) return F("Min");
+  return F("");
+}
+
+// ================= Feeder menu helpers =================
+int feederMaxIndex(FeederMode mode) {
+  if (mode == FEED_CUSTOM) return 4;  // On, Off
+  if (mode == FEED_BPM) return 3;     // Balls/min
+  return 2;
 }
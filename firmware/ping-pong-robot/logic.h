@@ -4,8 +4,8 @@
 #include "config.h"
 
 // ================= Auto state vars =================
-extern float panDir;
-extern float tiltDir;
+extern int8_t panDir;   // +1 / -1
+extern int8_t tiltDir;
 extern unsigned long panLastStepMs;
 extern unsigned long tiltLastStepMs;
 
@@ -13,8 +13,8 @@ extern const unsigned long AUTO2_PAUSE_MS;
 
 // ================= Globals =================
 extern Screen currentScreen;
-extern float livePan;
-extern float liveTilt;
+extern q16_t livePan;
+extern q16_t liveTilt;
 extern bool isRunning;
 extern unsigned long runStartMs;
 extern unsigned long maxPlayedMs;
@@ -27,6 +27,8 @@ extern int launcherIndex;
 extern int spinIndex;
 extern int feederIndex;
 extern int timerMenuIndex;
+extern int profileMenuIndex;  // 0: Load/Save, 1..PROFILE_SLOTS, then Back
+extern bool profileSaveMode;  // SW on a slot saves cfg instead of loading it
 extern int settingsIndex;  // 0=Servo1, 1=Servo2, 2=M1, 3=M2, 4=M3, 5=M4, 6=Back
 extern int settingsServoEditIndex;  // 0: MIN, 1: MID, 2: MAX, 3: Back
 extern int settingsServoSelected;  // 0: Servo 1 (TILT), 1: Servo 2 (PAN)
@@ -38,10 +40,10 @@ extern bool settingsMotorM4Revert; // sentido reverso no teste M4
 extern Config cfg;
 
 // ================= Auto update =================
-float auto1Update(float base, float &dir, float speed, float minVal, float maxVal);
-float auto2Update(float base, float &dir, unsigned long &lastStepMs, float step, unsigned long pauseMs, float minVal, float maxVal);
-void applyAuto(float &value, AxisMode mode, float &dir, unsigned long &lastStepMs, float auto1Speed, float auto2Step,
-               unsigned long auto2PauseMs, float minVal, float maxVal, unsigned long randomPauseMs, float randomMinDist);
+q16_t auto1Update(q16_t base, int8_t &dir, q16_t speed, q16_t minVal, q16_t maxVal);
+q16_t auto2Update(q16_t base, int8_t &dir, unsigned long &lastStepMs, q16_t step, unsigned long pauseMs, q16_t minVal, q16_t maxVal);
+void applyAuto(q16_t &value, AxisMode mode, int8_t &dir, unsigned long &lastStepMs, q16_t auto1Speed, q16_t auto2Step,
+               unsigned long auto2PauseMs, q16_t minVal, q16_t maxVal, unsigned long randomPauseMs, q16_t randomMinDist);
 
 // ================= Logic updates =================
 void updateRunningLogic();
@@ -50,11 +52,14 @@ void updateAxisPreviewTargets();
 // ================= Flow helpers =================
 void goBackToWizard();
 void cancelToHome();
-void startRunning();
+void startRunning(bool runDrill);  // runDrill: starts from the app run the drill program (drill.h)
 
 // ================= Axis menu helpers =================
 int axisMaxIndex(AxisMode mode);
 bool axisHasSecondOption(AxisMode mode);
-const char* axisSecondLabel(AxisMode mode);
+const __FlashStringHelper* axisSecondLabel(AxisMode mode);
+
+// ================= Feeder menu helpers =================
+int feederMaxIndex(FeederMode mode);  // Back item: Mode, Speed, [mode options], Back
 
 #endif
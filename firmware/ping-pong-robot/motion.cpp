@@ -0,0 +1,154 @@
+#include "motion.h"
+#include "config.h"
+#include "servos.h"
+
+// Limits per control tick: 1/4096 degree per tick, and per tick squared
+#define TICKS_PER_S     (1000000UL / CONTROL_TICK_US)
+#define MOTION_VMAX     ((int32_t)SERVO_MAX_DEG_PER_S * MOTION_DEG(1) / (int32_t)TICKS_PER_S)
+#define MOTION_ACCEL    ((int32_t)SERVO_ACCEL_DEG_PER_S2 * MOTION_DEG(1) / (int32_t)(TICKS_PER_S * TICKS_PER_S))
+
+struct MotionAxis {
+  int32_t pos;     // commanded angle
+  int32_t vel;     // per tick
+  int32_t target;
+  int32_t vmax;    // MOTION_VMAX, or less while this axis waits for the other one
+  int32_t accel;
+};
+
+static MotionAxis panAxis;
+static MotionAxis tiltAxis;
+
+static uint32_t isqrt32(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > n) bit >>= 2;
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+static void axisInit(MotionAxis& a, int deg) {
+  a.pos = MOTION_DEG(deg);
+  a.vel = 0;
+  a.target = a.pos;
+  a.vmax = MOTION_VMAX;
+  a.accel = MOTION_ACCEL;
+}
+
+// Ticks until the axis stops at its target: accelerate to a peak (capped at vmax), cruise, brake.
+// Moving away from the target first adds the stop. Distances are at most 180 deg, so 2 * accel *
+// d and vmax^2 fit in 32 bits.
+static uint32_t remainingTicks(const MotionAxis& a) {
+  int32_t d = a.target - a.pos;
+  int32_t v = a.vel;
+  if (d < 0) {
+    d = -d;
+    v = -v;
+  }
+  if (d == 0 && v == 0) return 0;
+
+  const uint32_t acc = (uint32_t)a.accel;
+  uint32_t ticks = 0;
+  if (v < 0) {
+    const uint32_t away = (uint32_t)-v;
+    ticks += away / acc;
+    d += (int32_t)(away * away / (2 * acc));
+    v = 0;
+  }
+  const uint32_t v0 = (uint32_t)v;
+  const uint32_t vmax = (uint32_t)a.vmax;
+  uint32_t peak = isqrt32((2 * acc * (uint32_t)d + v0 * v0) / 2);
+  if (peak > vmax) {
+    const uint32_t rampDist = (vmax * vmax - v0 * v0) / (2 * acc) + vmax * vmax / (2 * acc);
+    if ((uint32_t)d > rampDist) ticks += ((uint32_t)d - rampDist) / vmax;
+    peak = vmax;
+  }
+  if (peak < v0) peak = v0;  // too fast to stop in time: brakes through the target and snaps back
+  return ticks + (peak - v0) / acc + peak / acc;
+}
+
+// Stretching a rest-to-rest trapezoid in time by 1/s takes vmax * s and accel * s^2
+static void axisStretch(MotionAxis& a, uint32_t ticks, uint32_t longTicks) {
+  a.vmax = (int32_t)((uint32_t)MOTION_VMAX * ticks / longTicks);
+  a.accel = (int32_t)((uint32_t)MOTION_ACCEL * ticks / longTicks * ticks / longTicks);
+  if (a.vmax < 1) a.vmax = 1;
+  if (a.accel < 1) a.accel = 1;
+}
+
+// Braking from s by accel per tick covers s^2 / 2a - s / 2; this tick's step of s must leave that
+static bool canStop(int32_t s, int32_t dist, int32_t accel) {
+  return (int32_t)((uint32_t)s * (uint32_t)s / (2 * (uint32_t)accel)) + s / 2 <= dist;
+}
+
+static void axisStop(MotionAxis& a) {
+  a.pos = a.target;
+  a.vel = 0;
+  a.vmax = MOTION_VMAX;
+  a.accel = MOTION_ACCEL;
+}
+
+static void axisStep(MotionAxis& a) {
+  const int32_t d = a.target - a.pos;
+  if (d == 0 && a.vel == 0) return;
+
+  const int32_t dir = (d > 0) ? 1 : -1;
+  const int32_t dist = d * dir;
+  int32_t speed = a.vel * dir;  // > 0: moving toward the target
+  if (speed <= a.accel && dist <= a.accel) {
+    axisStop(a);
+    return;
+  }
+
+  // Fastest of accelerate / hold / brake that can still stop at the target
+  int32_t s = speed + a.accel;
+  if (s > a.vmax) s = (speed > a.vmax) ? speed - a.accel : a.vmax;
+  if (s > 0 && !canStop(s, dist, a.accel)) s = speed;
+  if (s > 0 && !canStop(s, dist, a.accel)) s = speed - a.accel;
+  a.vel = s * dir;
+  a.pos += a.vel;
+
+  // Reached or passed the target: stop there
+  if ((a.target - a.pos) * dir <= 0) axisStop(a);
+}
+
+void motionInit(int panDeg, int tiltDeg) {
+  axisInit(panAxis, panDeg);
+  axisInit(tiltAxis, tiltDeg);
+}
+
+void motionSetTarget(int32_t panPos, int32_t tiltPos) {
+  if (panPos == panAxis.target && tiltPos == tiltAxis.target) return;
+  // Only a move from rest is coordinated; a target that keeps moving is tracked at full speed
+  const bool fromRest = panAxis.vel == 0 && tiltAxis.vel == 0;
+  panAxis.target = panPos;
+  tiltAxis.target = tiltPos;
+  panAxis.vmax = tiltAxis.vmax = MOTION_VMAX;
+  panAxis.accel = tiltAxis.accel = MOTION_ACCEL;
+
+  if (!fromRest) return;
+  const uint32_t panTicks = remainingTicks(panAxis);
+  const uint32_t tiltTicks = remainingTicks(tiltAxis);
+  if (panTicks > tiltTicks && tiltTicks > 0) axisStretch(tiltAxis, tiltTicks, panTicks);
+  else if (tiltTicks > panTicks && panTicks > 0) axisStretch(panAxis, panTicks, tiltTicks);
+}
+
+void motionTick() {
+  axisStep(panAxis);
+  axisStep(tiltAxis);
+  writeServoPos(SERVO_PAN, panAxis.pos);
+  writeServoPos(SERVO_TILT, tiltAxis.pos);
+}
+
+unsigned long motionArrivalMs() {
+  uint32_t ticks = remainingTicks(panAxis);
+  const uint32_t tiltTicks = remainingTicks(tiltAxis);
+  if (tiltTicks > ticks) ticks = tiltTicks;
+  return ticks * (CONTROL_TICK_US / 1000UL);
+}
@@ -0,0 +1,21 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <Arduino.h>
+
+// Pan/tilt motion planner. updateServos() only sets a target; motionTick() moves each servo
+// toward it once per control tick along a trapezoidal profile (SERVO_MAX_DEG_PER_S,
+// SERVO_ACCEL_DEG_PER_S2). The profile is re-planned every tick from the current position and
+// speed, so a target that keeps moving (LIVE, AUTO1, streamed aim) is tracked as well. When a
+// target changes, the axis with the shorter move gets its limits scaled down so pan and tilt
+// arrive together. Angles are in 1/4096 degree (MOTION_DEG).
+
+#define MOTION_FRAC_BITS 12
+#define MOTION_DEG(d) ((int32_t)(d) << MOTION_FRAC_BITS)
+
+void motionInit(int panDeg, int tiltDeg);  // servos already written to these angles
+void motionSetTarget(int32_t panPos, int32_t tiltPos);
+void motionTick();                // every control tick: advances both axes and writes the servos
+unsigned long motionArrivalMs();  // predicted time until both axes are at their targets; 0 when there
+
+#endif
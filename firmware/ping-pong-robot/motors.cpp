@@ -1,7 +1,9 @@
 #include "motors.h"
 #include "config.h"
+#include "jam.h"
+#include "tach.h"
 #include <Arduino.h>
-#include <math.h>
+#include <avr/pgmspace.h>
 
 // Motores do launcher (M1, M2, M3)
 AF_DCMotor motor1(MOTOR_LAUNCHER_1);
@@ -15,6 +17,7 @@ AF_DCMotor motor4(MOTOR_FEEDER);
 unsigned long feederLastPulseMs = 0;
 bool feederPulseState = false;
 int feederPulseCount = 0;
+FeederPhase feederPhase = FEEDER_IDLE;
 
 // Cache dos valores dos motores
 int lastLauncherSpeed1 = -1;
@@ -35,108 +38,240 @@ void initMotors() {
   motor3.run(RELEASE);
   motor4.run(RELEASE);
 
-  // Reseta cache
-  lastLauncherSpeed1 = -1;
-  lastLauncherSpeed2 = -1;
-  lastLauncherSpeed3 = -1;
-  lastFeederSpeed = -1;
-  lastFeederRunning = false;
+  resetMotorCache();
+  initJamSensor();
+  initTach();
 }
 
 // Posições dos motores em graus: M1=12h(N), M2=4h(SE), M3=8h(SW)
-#define MOTOR_ANGLE_1  0.0
-#define MOTOR_ANGLE_2  120.0
-#define MOTOR_ANGLE_3  240.0
-#define DEG_TO_RAD    0.01745329252
-
-static float spinAlign(float motorDeg, float targetRad) {
-  float diffRad = (motorDeg * (float)DEG_TO_RAD) - targetRad;
-  float c = (float)cos((double)diffRad);
-  return (c + 1.0f) * 0.5f;  // 0..1
+#define MOTOR_ANGLE_1  0
+#define MOTOR_ANGLE_2  120
+#define MOTOR_ANGLE_3  240
+
+// ================= Spin mixing =================
+// Each launcher motor runs at power * (1 - k * drop), with k = spinIntensity / 255 and
+// drop = (1 - cos(motorAngle - spinAngle)) / 2 (0 when the motor faces the spin direction,
+// 1 when opposite). SpinMode has 9 values and the motor angles are fixed, so drop / 255 is
+// tabulated at compile time in Q22. power * intensity * entry plus the rounding bias reaches
+// 255 * 512 * 16448 + 2^21 = 2,149,548,032: past int32, so the product is taken in uint32_t.
+#define SPIN_DROP_SHIFT 22
+
+// C++11 constexpr (Arduino's avr-gcc): recursion instead of loops. Taylor series of cos on [-pi, pi].
+static constexpr double ctCosSeries(double x2, int n, double term, double sum) {
+  return n > 14 ? sum : ctCosSeries(x2, n + 1, -term * x2 / ((2.0 * n - 1.0) * (2.0 * n)),
+                                    sum - term * x2 / ((2.0 * n - 1.0) * (2.0 * n)));
+}
+static constexpr int ctWrapDeg(int deg) {
+  return deg > 180 ? ctWrapDeg(deg - 360) : deg < -180 ? ctWrapDeg(deg + 360) : deg;
+}
+static constexpr double ctCosDeg(int deg) {
+  return ctCosSeries((ctWrapDeg(deg) * 0.017453292519943295) * (ctWrapDeg(deg) * 0.017453292519943295), 1, 1.0, 1.0);
+}
+static constexpr uint16_t spinDrop(int motorDeg, int spinDeg) {
+  return spinDeg < 0 ? 0
+                     : (uint16_t)((1.0 - ctCosDeg(motorDeg - spinDeg)) * 0.5 * (double)(1UL << SPIN_DROP_SHIFT) / 255.0 + 0.5);
+}
+#define SPIN_ROW(deg) { spinDrop(MOTOR_ANGLE_1, deg), spinDrop(MOTOR_ANGLE_2, deg), spinDrop(MOTOR_ANGLE_3, deg) }
+
+// Indexed by SpinMode; angles as in spinModeToAngleDeg().
+static const uint16_t SPIN_DROP_TABLE[SPIN_MODE_COUNT][3] PROGMEM = {
+  SPIN_ROW(-1),   // NONE
+  SPIN_ROW(0),    // N
+  SPIN_ROW(45),   // NE
+  SPIN_ROW(90),   // E
+  SPIN_ROW(135),  // SE
+  SPIN_ROW(180),  // S
+  SPIN_ROW(225),  // SW
+  SPIN_ROW(270),  // W
+  SPIN_ROW(315),  // NW
+};
+
+static_assert(spinDrop(MOTOR_ANGLE_1, 0) == 0, "motor facing the spin keeps full power");
+static_assert(spinDrop(MOTOR_ANGLE_1, 180) == 16448, "opposite motor drops by power * intensity / 255");
+static_assert(spinDrop(MOTOR_ANGLE_2, 0) == 12336 && spinDrop(MOTOR_ANGLE_3, 0) == 12336, "120 deg off drops by 3/4");
+
+static int mixSpin(uint32_t powerTimesIntensity, uint16_t drop, int power) {
+  // No long in the expression: it is 64-bit on the host, and the simulator and bench must wrap
+  // exactly where the Mega would
+  const uint32_t d = powerTimesIntensity * drop + ((uint32_t)1 << (SPIN_DROP_SHIFT - 1));
+  // The drop is rounded to nearest before it is taken off power, so negative speeds round the same way
+  int speed = power - (int)(d >> SPIN_DROP_SHIFT);
+  // Limita ao range lógico -255..255 (negativo = girar em REVERSE)
+  return (speed < -255) ? -255 : (speed > 255) ? 255 : speed;
 }
 
-void updateLauncherMotors(int power, SpinMode spinMode, int spinIntensity) {
-  int baseSpeed = power;
-  int speed1 = baseSpeed;
-  int speed2 = baseSpeed;
-  int speed3 = baseSpeed;
-
-  int targetAngle = spinModeToAngleDeg(spinMode);
-  if (targetAngle < 0 || spinIntensity == 0) {
-    speed1 = baseSpeed;
-    speed2 = baseSpeed;
-    speed3 = baseSpeed;
-  } else {
-    // intensityFactor > 1 (intensity > 255) produz valores negativos = motor em REVERSE
-    float intensityFactor = (float)spinIntensity / 255.0f;
-    float targetRad = (float)targetAngle * (float)DEG_TO_RAD;
+// intensity > 255 produz valores negativos = motor em REVERSE (preview pode mostrar negativo)
+void getLauncherMotorSpeeds(int power, SpinMode spinMode, int spinIntensity, int &speed1, int &speed2, int &speed3) {
+  if ((unsigned)spinMode >= (unsigned)SPIN_MODE_COUNT) spinMode = SPIN_NONE;
+  // Range the uint32_t product is sized for (cfg already holds these limits)
+  power = (power < 0) ? 0 : (power > 255) ? 255 : power;
+  spinIntensity = (spinIntensity < 0) ? 0 : (spinIntensity > 512) ? 512 : spinIntensity;
+  const uint16_t* row = SPIN_DROP_TABLE[spinMode];
+  const uint32_t pi = (uint32_t)power * (uint32_t)spinIntensity;
+  speed1 = mixSpin(pi, pgm_read_word(&row[0]), power);
+  speed2 = mixSpin(pi, pgm_read_word(&row[1]), power);
+  speed3 = mixSpin(pi, pgm_read_word(&row[2]), power);
+}
 
-    float a1 = spinAlign((float)MOTOR_ANGLE_1, targetRad);
-    float a2 = spinAlign((float)MOTOR_ANGLE_2, targetRad);
-    float a3 = spinAlign((float)MOTOR_ANGLE_3, targetRad);
+// Launcher ramp: lastLauncherSpeedN is the ramped signed PWM of each motor, and it moves toward
+// the mixed target by at most LAUNCHER_SLEW_PER_TICK per control tick. The motor is driven at
+// that plus the wheel speed trim (launcherPwm).
+static int launcherTarget[3] = { 0, 0, 0 };
+static int launcherPwm[3] = { 0, 0, 0 };  // signed PWM written to the shield
+static bool launcherForceWrite = true;  // after resetMotorCache: driver state unknown
+
+#if LAUNCHER_TACH
+// Wheel speed loop: the ramped PWM is the feedforward and sets the RPM setpoint; a PI trim on top
+// holds it as the battery sags and the wheels wear. No D term: at 200 Hz it would mostly amplify
+// tach period jitter. The integrator only runs once the ramp is at its target, and a wheel whose
+// tach stays silent (TACH_FAULT_MS) drops to open loop until the next run.
+static int32_t launcherInteg[3] = { 0, 0, 0 };  // Q16 PWM
+static int launcherTrim[3] = { 0, 0, 0 };
+static int16_t launcherRpmError[3] = { 0, 0, 0 };
+static unsigned long launcherSilentMs[3] = { 0, 0, 0 };
+static bool launcherOpenLoop[3] = { false, false, false };
+
+static int32_t launcherSetRpm(int ramp) {
+  return (int32_t)(ramp < 0 ? -ramp : ramp) * LAUNCHER_RPM_AT_FULL / 255;
+}
 
-    speed1 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a1)) + 0.5f);
-    speed2 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a2)) + 0.5f);
-    speed3 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a3)) + 0.5f);
+static int wheelTrim(uint8_t i, int ramp) {
+  const int32_t setRpm = launcherSetRpm(ramp);
+  if (setRpm < LAUNCHER_RPM_MIN) {
+    launcherSilentMs[i] = 0;
+    launcherInteg[i] = 0;
+    launcherRpmError[i] = 0;
+    return launcherTrim[i] = 0;
   }
-
-  // Limita ao range lógico -255..255 (negativo = girar em REVERSE)
-  speed1 = (speed1 < -255) ? -255 : (speed1 > 255) ? 255 : speed1;
-  speed2 = (speed2 < -255) ? -255 : (speed2 > 255) ? 255 : speed2;
-  speed3 = (speed3 < -255) ? -255 : (speed3 > 255) ? 255 : speed3;
-
-  // Aplica: valor negativo = BACKWARD com |speed|, positivo = FORWARD
-  if (speed1 != lastLauncherSpeed1) {
-    int mag1 = (speed1 < 0) ? -speed1 : speed1;
-    motor1.setSpeed(mag1);
-    motor1.run(speed1 < 0 ? BACKWARD : FORWARD);
-    lastLauncherSpeed1 = speed1;
+  if (launcherRpm[i] == 0 && !launcherOpenLoop[i]) {
+    launcherSilentMs[i] += CONTROL_TICK_US / 1000UL;
+    if (launcherSilentMs[i] >= TACH_FAULT_MS) launcherOpenLoop[i] = true;
+  } else {
+    launcherSilentMs[i] = 0;
   }
-  if (speed2 != lastLauncherSpeed2) {
-    int mag2 = (speed2 < 0) ? -speed2 : speed2;
-    motor2.setSpeed(mag2);
-    motor2.run(speed2 < 0 ? BACKWARD : FORWARD);
-    lastLauncherSpeed2 = speed2;
+  if (launcherOpenLoop[i]) {
+    launcherRpmError[i] = 0;
+    return launcherTrim[i] = 0;
   }
-  if (speed3 != lastLauncherSpeed3) {
-    int mag3 = (speed3 < 0) ? -speed3 : speed3;
-    motor3.setSpeed(mag3);
-    motor3.run(speed3 < 0 ? BACKWARD : FORWARD);
-    lastLauncherSpeed3 = speed3;
+
+  const int32_t err = setRpm - (int32_t)launcherRpm[i];
+  const int32_t trimMaxQ16 = (int32_t)LAUNCHER_TRIM_MAX << 16;
+  if (ramp == launcherTarget[i]) {
+    launcherInteg[i] += err * LAUNCHER_PI_KI_Q16;
+    if (launcherInteg[i] > trimMaxQ16) launcherInteg[i] = trimMaxQ16;
+    if (launcherInteg[i] < -trimMaxQ16) launcherInteg[i] = -trimMaxQ16;
   }
+  int32_t trim = (err * LAUNCHER_PI_KP_Q16 + launcherInteg[i]) >> 16;
+  if (trim > LAUNCHER_TRIM_MAX) trim = LAUNCHER_TRIM_MAX;
+  if (trim < -LAUNCHER_TRIM_MAX) trim = -LAUNCHER_TRIM_MAX;
+  launcherRpmError[i] = (int16_t)(err > 32767 ? 32767 : err < -32767 ? -32767 : err);
+  launcherTrim[i] = (int)trim;
+  return ramp < 0 ? -(int)trim : (int)trim;
 }
 
-void getLauncherMotorSpeeds(int power, SpinMode spinMode, int spinIntensity, int &speed1, int &speed2, int &speed3) {
-  int baseSpeed = power;
-  speed1 = baseSpeed;
-  speed2 = baseSpeed;
-  speed3 = baseSpeed;
-
-  int targetAngle = spinModeToAngleDeg(spinMode);
-  if (targetAngle < 0 || spinIntensity == 0) {
-    speed1 = baseSpeed;
-    speed2 = baseSpeed;
-    speed3 = baseSpeed;
-  } else {
-    float intensityFactor = (float)spinIntensity / 255.0f;
-    float targetRad = (float)targetAngle * (float)DEG_TO_RAD;
+// Within LAUNCHER_RPM_READY_PCT, or as close as the loop can get (trim saturated), or open loop
+static bool wheelSettled(uint8_t i) {
+  const int32_t setRpm = launcherSetRpm(launcherTarget[i]);
+  if (setRpm < LAUNCHER_RPM_MIN || launcherOpenLoop[i]) return true;
+  if (launcherTrim[i] >= LAUNCHER_TRIM_MAX || launcherTrim[i] <= -LAUNCHER_TRIM_MAX) return true;
+  const int32_t err = launcherRpmError[i] < 0 ? -(int32_t)launcherRpmError[i] : launcherRpmError[i];
+  return err * 100 <= setRpm * LAUNCHER_RPM_READY_PCT;
+}
+
+static void resetWheelLoops() {
+  for (uint8_t i = 0; i < 3; i++) {
+    launcherInteg[i] = 0;
+    launcherTrim[i] = 0;
+    launcherRpmError[i] = 0;
+    launcherSilentMs[i] = 0;
+    launcherOpenLoop[i] = false;
+  }
+}
+#else
+static int wheelTrim(uint8_t i, int ramp) { return 0; }
+static bool wheelSettled(uint8_t i) { return true; }
+static void resetWheelLoops() {}
+#endif
+
+static int stepToward(int from, int to) {
+  if (to > from + LAUNCHER_SLEW_PER_TICK) to = from + LAUNCHER_SLEW_PER_TICK;
+  if (to < from - LAUNCHER_SLEW_PER_TICK) to = from - LAUNCHER_SLEW_PER_TICK;
+  // A reversal stops at zero for one tick before the direction flips
+  if ((from > 0 && to < 0) || (from < 0 && to > 0)) to = 0;
+  return to;
+}
+
+static void rampLauncherMotor(uint8_t i, AF_DCMotor &motor, int &ramp) {
+  ramp = stepToward(ramp, launcherTarget[i]);
+  // The trim never takes the motor past zero, so a reversal still stops for a tick
+  int next = ramp + wheelTrim(i, ramp);
+  if (ramp > 0) next = (next < 0) ? 0 : (next > 255) ? 255 : next;
+  if (ramp < 0) next = (next > 0) ? 0 : (next < -255) ? -255 : next;
+  int &out = launcherPwm[i];
+  if (next == out && !launcherForceWrite) return;
+  // Aplica: valor negativo = BACKWARD com |speed|, positivo = FORWARD
+  motor.setSpeed(next < 0 ? -next : next);
+  // run() rewrites the shield latch; only needed when the direction changes
+  int8_t dirOld = (out > 0) - (out < 0), dirNew = (next > 0) - (next < 0);
+  if (dirNew != dirOld || launcherForceWrite) motor.run(dirNew < 0 ? BACKWARD : dirNew > 0 ? FORWARD : RELEASE);
+  out = next;
+}
+
+void updateLauncherMotors(int power, SpinMode spinMode, int spinIntensity) {
+  getLauncherMotorSpeeds(power, spinMode, spinIntensity, launcherTarget[0], launcherTarget[1], launcherTarget[2]);
+  tachUpdate();
+  rampLauncherMotor(0, motor1, lastLauncherSpeed1);
+  rampLauncherMotor(1, motor2, lastLauncherSpeed2);
+  rampLauncherMotor(2, motor3, lastLauncherSpeed3);
+  launcherForceWrite = false;
+}
+
+bool launcherAtTarget() {
+  return lastLauncherSpeed1 == launcherTarget[0] && lastLauncherSpeed2 == launcherTarget[1] &&
+         lastLauncherSpeed3 == launcherTarget[2] && wheelSettled(0) && wheelSettled(1) && wheelSettled(2);
+}
 
-    float a1 = spinAlign((float)MOTOR_ANGLE_1, targetRad);
-    float a2 = spinAlign((float)MOTOR_ANGLE_2, targetRad);
-    float a3 = spinAlign((float)MOTOR_ANGLE_3, targetRad);
+// Feeder disc calibration at 7.5 V, continuous: 70 -> 4.50 s, 160 -> 2.91 s, 255 -> 2.60 s per
+// turn, linear in between; below 70 it slows toward 6 s. FEEDER_DISC_HOLES balls per turn.
+unsigned long feederMsPerRotation(int speed) {
+  if (speed <= 0) return 6000UL;
+  if (speed <= 70) return 4500UL + (unsigned long)(70 - speed) * 1500UL / 70UL;
+  if (speed <= 160) return 4500UL - (unsigned long)(speed - 70) * 1590UL / 90UL;
+  if (speed <= 255) return 2910UL - (unsigned long)(speed - 160) * 310UL / 95UL;
+  return 2600UL;
+}
 
-    speed1 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a1)) + 0.5f);
-    speed2 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a2)) + 0.5f);
-    speed3 = (int)(baseSpeed * (1.0f - intensityFactor * (1.0f - a3)) + 0.5f);
+bool feederPulseTiming(const Config &c, unsigned long &onMs, unsigned long &offMs) {
+  switch (c.feederMode) {
+    case FEED_PULSE_1_1: onMs = 1000UL; offMs = 1000UL; return true;
+    case FEED_PULSE_2_1: onMs = 2000UL; offMs = 1000UL; return true;
+    case FEED_PULSE_2_2: onMs = 2000UL; offMs = 2000UL; return true;
+    case FEED_CUSTOM:    onMs = c.feederCustomOnMs; offMs = c.feederCustomOffMs; return true;
+    case FEED_BPM: {
+      // One disc hole per pulse; the rest of the 60000 / bpm cycle is off. A target above the
+      // continuous rate at this speed gives back-to-back pulses.
+      unsigned long cycleMs = 60000UL / (unsigned long)(c.feederBpm > 0 ? c.feederBpm : 1);
+      onMs = feederMsPerRotation(c.feederSpeed) / FEEDER_DISC_HOLES;
+      offMs = cycleMs > onMs ? cycleMs - onMs : 0;
+      return true;
+    }
+    default:
+      onMs = 0;
+      offMs = 0;
+      return false;
   }
+}
 
-  // Limita ao range lógico -255..255 (preview pode mostrar negativo)
-  speed1 = (speed1 < -255) ? -255 : (speed1 > 255) ? 255 : speed1;
-  speed2 = (speed2 < -255) ? -255 : (speed2 > 255) ? 255 : speed2;
-  speed3 = (speed3 < -255) ? -255 : (speed3 > 255) ? 255 : speed3;
+int feederBallCount() {
+#if FEEDER_EXIT_SENSOR
+  return (int)ballsOut;
+#else
+  return feederPulseCount;
+#endif
 }
 
-void updateFeederMotor(int speed, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs, unsigned long runStartMs) {
+void updateFeederMotor(int speed, FeederMode mode, unsigned long onMs, unsigned long offMs, unsigned long runStartMs,
+                       bool feedReady) {
   unsigned long now = millis();
 
   // Recuada padrão ao iniciar partida: M4 gira em reverso por FEEDER_PULLBACK_MS para a bolinha recuar antes do spin máximo
@@ -149,49 +284,80 @@ void updateFeederMotor(int speed, FeederMode mode, unsigned long customOnMs, uns
     }
     motor4.run(BACKWARD);
     lastFeederRunning = true;
+    feederPhase = FEEDER_PULLBACK;
     return;
   }
+
+  // Un-jam cycle (jam.h) takes M4 over at full speed until it is done
+  static int8_t lastUnjam = 0;
+  static int jamSpeed = -1;
+  static unsigned long jamBallMs = 0;
+  if (speed != jamSpeed) {
+    jamBallMs = feederMsPerRotation(speed) / FEEDER_DISC_HOLES;
+    jamSpeed = speed;
+  }
+  const int8_t unjam = jamUpdate(now, lastFeederRunning && feederPhase == FEEDER_ON, jamBallMs);
+  if (unjam != 0) {
+    if (unjam != lastUnjam) {
+      motor4.setSpeed(255);
+      motor4.run(unjam < 0 ? BACKWARD : FORWARD);
+      lastUnjam = unjam;
+    }
+    feederPhase = FEEDER_UNJAM;
+    return;
+  }
+  if (lastUnjam != 0) {
+    // Back to normal: stopped, next pulse as soon as the shot is ready
+    motor4.run(RELEASE);
+    lastUnjam = 0;
+    lastFeederRunning = false;
+    lastFeederSpeed = -1;
+    feederPulseState = false;
+    feederLastPulseMs = now - (onMs + offMs);
+  }
+
   if (wasInPullback) {
     lastFeederRunning = false;
     lastFeederSpeed = -1;
     wasInPullback = false;
+    // The first pulse starts as soon as the shot is ready
+    feederPulseState = false;
+    feederLastPulseMs = now - (onMs + offMs);
   }
 
-  bool shouldRun = false;
-  switch (mode) {
-    case FEED_CONTINUOUS:
-      shouldRun = true;
-      break;
-
-    case FEED_PULSE_1_1: {
-      unsigned long cycleTime = now % 2000UL;
-      shouldRun = (cycleTime < 1000UL);
-      break;
-    }
-
-    case FEED_PULSE_2_1: {
-      unsigned long cycleTime = now % 3000UL;
-      shouldRun = (cycleTime < 2000UL);
-      break;
-    }
-
-    case FEED_PULSE_2_2: {
-      unsigned long cycleTime = now % 4000UL;
-      shouldRun = (cycleTime < 2000UL);
-      break;
-    }
+  // In BPM mode with the exit sensor, a pulse ends when its ball is out (or after twice the
+  // calibrated time), and the off phase makes up the rest of the cycle.
+  static unsigned long pulseOnMs = 0;  // length of the last ON phase
+#if FEEDER_EXIT_SENSOR
+  const bool endOnBall = mode == FEED_BPM;
+#else
+  const bool endOnBall = false;
+#endif
 
-    case FEED_CUSTOM: {
-      unsigned long cycleMs = customOnMs + customOffMs;
-      if (cycleMs == 0) break;
-      unsigned long cycleTime = now % cycleMs;
-      shouldRun = (cycleTime < customOnMs);
-      break;
+  bool shouldRun = false;
+  if (mode == FEED_CONTINUOUS) {
+    shouldRun = true;
+  } else if (onMs > 0) {
+    // Each phase is timed from its own start: an ON phase lasts onMs, and the next one starts
+    // once the on + off cycle is over and feedReady allows it.
+    unsigned long inPhase = now - feederLastPulseMs;
+    if (feederPulseState) {
+      if (inPhase >= (endOnBall ? 2 * onMs : onMs) || (endOnBall && jamBallSeen())) {
+        feederPulseState = false;
+        feederLastPulseMs = now;
+        pulseOnMs = inPhase;
+      }
+    } else {
+      unsigned long cycleMs = onMs + offMs;
+      unsigned long offNeeded = cycleMs > pulseOnMs ? cycleMs - pulseOnMs : 0;
+      if (inPhase >= offNeeded && feedReady) {
+        feederPulseState = true;
+        feederLastPulseMs = now;
+      }
     }
-
-    default:
-      shouldRun = false;
-      break;
+    shouldRun = feederPulseState;
+  } else {
+    feederPulseState = false;
   }
 
   // Só atualiza velocidade se mudou
@@ -204,29 +370,28 @@ void updateFeederMotor(int speed, FeederMode mode, unsigned long customOnMs, uns
   if (shouldRun != lastFeederRunning) {
     if (shouldRun) {
       motor4.run(FORWARD);
+      feederPulseCount++;
     } else {
       motor4.run(RELEASE);
     }
     lastFeederRunning = shouldRun;
   }
+  feederPhase = shouldRun ? FEEDER_ON : FEEDER_OFF;
 }
 
 void resetMotorCache() {
-  // Reseta cache para forçar atualização na próxima vez
-  lastLauncherSpeed1 = -1;
-  lastLauncherSpeed2 = -1;
-  lastLauncherSpeed3 = -1;
+  // Reseta cache para forçar atualização na próxima vez; os launchers voltam a rampa a partir de 0
+  lastLauncherSpeed1 = 0;
+  lastLauncherSpeed2 = 0;
+  lastLauncherSpeed3 = 0;
+  launcherTarget[0] = launcherTarget[1] = launcherTarget[2] = 0;
+  launcherPwm[0] = launcherPwm[1] = launcherPwm[2] = 0;
+  launcherForceWrite = true;
+  resetWheelLoops();
   lastFeederSpeed = -1;
   lastFeederRunning = false;
 }
 
-void setMotorCache(int s1, int s2, int s3) {
-  // Define o cache manualmente
-  lastLauncherSpeed1 = s1;
-  lastLauncherSpeed2 = s2;
-  lastLauncherSpeed3 = s3;
-}
-
 void runSingleMotor(int which, int speed, bool m4Revert) {
   motor1.run(RELEASE);
   motor2.run(RELEASE);
@@ -258,4 +423,6 @@ void stopAllMotors() {
   motor4.run(RELEASE);
 
   resetMotorCache();
+  feederPulseState = false;
+  feederPhase = FEEDER_IDLE;
 }
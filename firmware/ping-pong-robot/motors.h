@@ -10,16 +10,28 @@
 #define MOTOR_LAUNCHER_3 3  // M3
 #define MOTOR_FEEDER     4  // M4
 
+#define FEEDER_DISC_HOLES 3  // balls per feeder disc turn
+
 // Spin intensity via Config.spinIntensity (0-512); >255 permite motor em REVERSE (preview pode mostrar negativo)
 
 void initMotors();
+// Every running control tick: sets the mixed speeds as targets and ramps M1..M3 toward them
+// (LAUNCHER_SLEW_PER_TICK, reversals through zero); with LAUNCHER_TACH a PI trim holds each
+// wheel at the RPM its ramped PWM stands for.
 void updateLauncherMotors(int power, SpinMode spinMode, int spinIntensity);
-void updateFeederMotor(int speed, FeederMode mode, unsigned long customOnMs, unsigned long customOffMs, unsigned long runStartMs);
+bool launcherAtTarget();  // ramps done and, with tachs, wheels up to speed
+// onMs/offMs from feederPulseTiming(). Pulsed modes time each ON/OFF phase from its own start; an
+// OFF phase is stretched until feedReady (the shot scheduler's "aim and spin have settled")
+// before the next ball is fed.
+void updateFeederMotor(int speed, FeederMode mode, unsigned long onMs, unsigned long offMs, unsigned long runStartMs,
+                       bool feedReady = true);
+bool feederPulseTiming(const Config &c, unsigned long &onMs, unsigned long &offMs);  // false (0/0) if not pulsed
+unsigned long feederMsPerRotation(int speed);  // calibrated at 7.5 V
+int feederBallCount();  // balls this run: exit sensor count if fitted, else feeder pulses
 void stopAllMotors();
 void runSingleMotor(int which, int speed, bool m4Revert = false);  // which 1..4; m4Revert inverte M4
 void getLauncherMotorSpeeds(int power, SpinMode spinMode, int spinIntensity, int &speed1, int &speed2, int &speed3);
-void resetMotorCache();
-void setMotorCache(int s1, int s2, int s3);
+void resetMotorCache();  // also restarts the launcher ramps from 0
 
 // Expor os motores para acesso direto quando necessário
 extern AF_DCMotor motor1;
@@ -28,11 +40,15 @@ extern AF_DCMotor motor3;
 extern AF_DCMotor motor4;
 
 // Variáveis de estado do feeder
-extern unsigned long feederLastPulseMs;
-extern bool feederPulseState;
-extern int feederPulseCount;
+enum FeederPhase : uint8_t { FEEDER_IDLE = 0, FEEDER_PULLBACK, FEEDER_ON, FEEDER_OFF, FEEDER_UNJAM };
+
+extern unsigned long feederLastPulseMs;  // start of the current pulse phase
+extern bool feederPulseState;           // true during a pulse ON phase
+extern int feederPulseCount;     // feeder ON phases started in the current run (one ball each)
+extern FeederPhase feederPhase;
 
 // Cache dos valores dos motores para evitar atualizações desnecessárias
+// (launchers: signed ramp output, before the wheel speed trim)
 extern int lastLauncherSpeed1;
 extern int lastLauncherSpeed2;
 extern int lastLauncherSpeed3;
@@ -10,7 +10,13 @@
 #include "screens.h"
 #include "servos.h"
 #include "motors.h"
+#include "profiles.h"
 #include "bt_command.h"
+#include "control.h"
+#include "profiler.h"
+#include "ram.h"
+#include "telemetry.h"
+#include "tx_queue.h"
 
 // ================= Main =================
 void setup() {
@@ -20,15 +26,27 @@ void setup() {
   initDisplay();
   initServos();
   initMotors();
+  initProfiles();  // after initServos: the last run's config moves the servos to its targets
   initBTCommand();
+  initControl();
+
+  TxLine ram(TX_LOG, true);
+  ramReport(ram, F("[RAM] "));
 }
 
 void loop() {
+  profLoopBegin();
   processBTInput();
+  updateTelemetry();
+  txDrain();
+  profilesPoll();
+  profMark(PROF_BT_INPUT);
   updateBTState();
+  profMark(PROF_BT_STATE);
   updateButton();
-  updateRunningLogic();
-  updateAxisPreviewTargets();
+  profMark(PROF_BUTTON);
+  runControlTicks();
+  profMark(PROF_CONTROL);
 
   // Long press em qualquer tela volta para Home (exceto se já estiver no Home)
   if (swLongPressEvent && currentScreen != SCREEN_HOME) {
@@ -47,19 +65,44 @@ void loop() {
 
   switch (currentScreen) {
     case SCREEN_HOME: {
-      if (nav == NAV_UP) homeIndex = clampInt(homeIndex - 1, 0, 2);
-      if (nav == NAV_DOWN) homeIndex = clampInt(homeIndex + 1, 0, 2);
+      if (nav == NAV_UP) homeIndex = clampInt(homeIndex - 1, 0, 3);
+      if (nav == NAV_DOWN) homeIndex = clampInt(homeIndex + 1, 0, 3);
 
       if (swPressedEvent) {
         if (homeIndex == 0) currentScreen = SCREEN_WIZARD;
-        if (homeIndex == 1) currentScreen = SCREEN_INFO;
-        if (homeIndex == 2) { settingsIndex = 0; currentScreen = SCREEN_SETTINGS; }
+        if (homeIndex == 1) { profileMenuIndex = 1; currentScreen = SCREEN_PROFILES; }
+        if (homeIndex == 2) { ramScan(); currentScreen = SCREEN_INFO; }
+        if (homeIndex == 3) { settingsIndex = 0; currentScreen = SCREEN_SETTINGS; }
       }
 
       renderHome();
       break;
     }
 
+    case SCREEN_PROFILES: {
+      // 0 = Load/Save, 1..PROFILE_SLOTS = slots, then Back
+      if (nav == NAV_UP) profileMenuIndex = clampInt(profileMenuIndex - 1, 0, PROFILE_SLOTS + 1);
+      if (nav == NAV_DOWN) profileMenuIndex = clampInt(profileMenuIndex + 1, 0, PROFILE_SLOTS + 1);
+
+      if (profileMenuIndex == 0 && (nav == NAV_LEFT || nav == NAV_RIGHT)) profileSaveMode = !profileSaveMode;
+
+      if (swPressedEvent) {
+        if (profileMenuIndex == PROFILE_SLOTS + 1) {
+          currentScreen = SCREEN_HOME;
+        } else if (profileMenuIndex >= 1) {
+          if (profileSaveMode) {
+            profileSave((uint8_t)profileMenuIndex, "");
+          } else if (profileLoad((uint8_t)profileMenuIndex)) {
+            wizardIndex = 0;
+            currentScreen = SCREEN_WIZARD;
+          }
+        }
+      }
+
+      renderProfiles();
+      break;
+    }
+
     case SCREEN_INFO: {
       if (swPressedEvent) currentScreen = SCREEN_HOME;
       renderInfo();
@@ -196,7 +239,7 @@ void loop() {
         if (wizardIndex == 2) { launcherIndex = 0; currentScreen = SCREEN_LAUNCHER; }
         if (wizardIndex == 3) { feederIndex = 0; currentScreen = SCREEN_FEEDER; }
         if (wizardIndex == 4) { timerMenuIndex = 0; currentScreen = SCREEN_TIMER; }
-        if (wizardIndex == 5) { startRunning(); }
+        if (wizardIndex == 5) { startRunning(false); }
       }
 
       renderWizard();
@@ -212,35 +255,35 @@ void loop() {
       if (panMenuIndex == 0) {
         if (nav == NAV_LEFT)  cfg.panMode = (AxisMode)((cfg.panMode + AXIS_MODE_COUNT - 1) % AXIS_MODE_COUNT);
         if (nav == NAV_RIGHT) cfg.panMode = (AxisMode)((cfg.panMode + 1) % AXIS_MODE_COUNT);
-        if (cfg.panMode == AXIS_LIVE) { cfg.panMin = -1.0f; cfg.panMax = 1.0f; }
+        if (cfg.panMode == AXIS_LIVE) { cfg.panMin = -Q16_ONE; cfg.panMax = Q16_ONE; }
       }
 
       if (cfg.panMode == AXIS_AUTO1 && panMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.panAuto1Speed = clampFloat(cfg.panAuto1Speed - 0.005f, 0.005f, 0.080f);
-        if (nav == NAV_RIGHT) cfg.panAuto1Speed = clampFloat(cfg.panAuto1Speed + 0.005f, 0.005f, 0.080f);
+        if (nav == NAV_LEFT)  cfg.panAuto1Speed = q16Clamp(cfg.panAuto1Speed - Q16(0.005), Q16(0.005), Q16(0.080));
+        if (nav == NAV_RIGHT) cfg.panAuto1Speed = q16Clamp(cfg.panAuto1Speed + Q16(0.005), Q16(0.005), Q16(0.080));
       }
 
       if (cfg.panMode == AXIS_AUTO2 && panMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.panAuto2Step = clampFloat(cfg.panAuto2Step - 0.05f, 0.05f, 0.50f);
-        if (nav == NAV_RIGHT) cfg.panAuto2Step = clampFloat(cfg.panAuto2Step + 0.05f, 0.05f, 0.50f);
+        if (nav == NAV_LEFT)  cfg.panAuto2Step = q16Clamp(cfg.panAuto2Step - Q16(0.05), Q16(0.05), Q16(0.50));
+        if (nav == NAV_RIGHT) cfg.panAuto2Step = q16Clamp(cfg.panAuto2Step + Q16(0.05), Q16(0.05), Q16(0.50));
       }
 
       if ((cfg.panMode == AXIS_AUTO1 || cfg.panMode == AXIS_AUTO2) && panMenuIndex == 2) {
-        if (nav == NAV_LEFT)  cfg.panMin = clampFloat(cfg.panMin - 0.05f, -1.0f, cfg.panMax - 0.05f);
-        if (nav == NAV_RIGHT) cfg.panMin = clampFloat(cfg.panMin + 0.05f, -1.0f, cfg.panMax - 0.05f);
+        if (nav == NAV_LEFT)  cfg.panMin = q16Clamp(cfg.panMin - Q16(0.05), -Q16_ONE, cfg.panMax - Q16(0.05));
+        if (nav == NAV_RIGHT) cfg.panMin = q16Clamp(cfg.panMin + Q16(0.05), -Q16_ONE, cfg.panMax - Q16(0.05));
       }
       if ((cfg.panMode == AXIS_AUTO1 || cfg.panMode == AXIS_AUTO2) && panMenuIndex == 3) {
-        if (nav == NAV_LEFT)  cfg.panMax = clampFloat(cfg.panMax - 0.05f, cfg.panMin + 0.05f, 1.0f);
-        if (nav == NAV_RIGHT) cfg.panMax = clampFloat(cfg.panMax + 0.05f, cfg.panMin + 0.05f, 1.0f);
+        if (nav == NAV_LEFT)  cfg.panMax = q16Clamp(cfg.panMax - Q16(0.05), cfg.panMin + Q16(0.05), Q16_ONE);
+        if (nav == NAV_RIGHT) cfg.panMax = q16Clamp(cfg.panMax + Q16(0.05), cfg.panMin + Q16(0.05), Q16_ONE);
       }
 
       if (cfg.panMode == AXIS_RANDOM && panMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.panMin = clampFloat(cfg.panMin - 0.05f, -1.0f, cfg.panMax - 0.05f);
-        if (nav == NAV_RIGHT) cfg.panMin = clampFloat(cfg.panMin + 0.05f, -1.0f, cfg.panMax - 0.05f);
+        if (nav == NAV_LEFT)  cfg.panMin = q16Clamp(cfg.panMin - Q16(0.05), -Q16_ONE, cfg.panMax - Q16(0.05));
+        if (nav == NAV_RIGHT) cfg.panMin = q16Clamp(cfg.panMin + Q16(0.05), -Q16_ONE, cfg.panMax - Q16(0.05));
       }
       if (cfg.panMode == AXIS_RANDOM && panMenuIndex == 2) {
-        if (nav == NAV_LEFT)  cfg.panMax = clampFloat(cfg.panMax - 0.05f, cfg.panMin + 0.05f, 1.0f);
-        if (nav == NAV_RIGHT) cfg.panMax = clampFloat(cfg.panMax + 0.05f, cfg.panMin + 0.05f, 1.0f);
+        if (nav == NAV_LEFT)  cfg.panMax = q16Clamp(cfg.panMax - Q16(0.05), cfg.panMin + Q16(0.05), Q16_ONE);
+        if (nav == NAV_RIGHT) cfg.panMax = q16Clamp(cfg.panMax + Q16(0.05), cfg.panMin + Q16(0.05), Q16_ONE);
       }
       if (cfg.panMode == AXIS_RANDOM && panMenuIndex == 3) {
         if (nav == NAV_LEFT)  cfg.panRandomPauseMs = (unsigned long)clampInt((int)(cfg.panRandomPauseMs - 250), 500, 10000);
@@ -255,7 +298,7 @@ void loop() {
         }
       }
 
-      renderAxisMenu("PAN", cfg.panMode, cfg.panTarget, panMenuIndex);
+      renderAxisMenu(true, cfg.panMode, cfg.panTarget, panMenuIndex);
       break;
     }
 
@@ -268,35 +311,35 @@ void loop() {
       if (tiltMenuIndex == 0) {
         if (nav == NAV_LEFT)  cfg.tiltMode = (AxisMode)((cfg.tiltMode + AXIS_MODE_COUNT - 1) % AXIS_MODE_COUNT);
         if (nav == NAV_RIGHT) cfg.tiltMode = (AxisMode)((cfg.tiltMode + 1) % AXIS_MODE_COUNT);
-        if (cfg.tiltMode == AXIS_LIVE) { cfg.tiltMin = -1.0f; cfg.tiltMax = 1.0f; }
+        if (cfg.tiltMode == AXIS_LIVE) { cfg.tiltMin = -Q16_ONE; cfg.tiltMax = Q16_ONE; }
       }
 
       if (cfg.tiltMode == AXIS_AUTO1 && tiltMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.tiltAuto1Speed = clampFloat(cfg.tiltAuto1Speed - 0.005f, 0.005f, 0.080f);
-        if (nav == NAV_RIGHT) cfg.tiltAuto1Speed = clampFloat(cfg.tiltAuto1Speed + 0.005f, 0.005f, 0.080f);
+        if (nav == NAV_LEFT)  cfg.tiltAuto1Speed = q16Clamp(cfg.tiltAuto1Speed - Q16(0.005), Q16(0.005), Q16(0.080));
+        if (nav == NAV_RIGHT) cfg.tiltAuto1Speed = q16Clamp(cfg.tiltAuto1Speed + Q16(0.005), Q16(0.005), Q16(0.080));
       }
 
       if (cfg.tiltMode == AXIS_AUTO2 && tiltMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.tiltAuto2Step = clampFloat(cfg.tiltAuto2Step - 0.05f, 0.05f, 0.50f);
-        if (nav == NAV_RIGHT) cfg.tiltAuto2Step = clampFloat(cfg.tiltAuto2Step + 0.05f, 0.05f, 0.50f);
+        if (nav == NAV_LEFT)  cfg.tiltAuto2Step = q16Clamp(cfg.tiltAuto2Step - Q16(0.05), Q16(0.05), Q16(0.50));
+        if (nav == NAV_RIGHT) cfg.tiltAuto2Step = q16Clamp(cfg.tiltAuto2Step + Q16(0.05), Q16(0.05), Q16(0.50));
       }
 
       if ((cfg.tiltMode == AXIS_AUTO1 || cfg.tiltMode == AXIS_AUTO2) && tiltMenuIndex == 2) {
-        if (nav == NAV_LEFT)  cfg.tiltMin = clampFloat(cfg.tiltMin - 0.05f, -1.0f, cfg.tiltMax - 0.05f);
-        if (nav == NAV_RIGHT) cfg.tiltMin = clampFloat(cfg.tiltMin + 0.05f, -1.0f, cfg.tiltMax - 0.05f);
+        if (nav == NAV_LEFT)  cfg.tiltMin = q16Clamp(cfg.tiltMin - Q16(0.05), -Q16_ONE, cfg.tiltMax - Q16(0.05));
+        if (nav == NAV_RIGHT) cfg.tiltMin = q16Clamp(cfg.tiltMin + Q16(0.05), -Q16_ONE, cfg.tiltMax - Q16(0.05));
       }
       if ((cfg.tiltMode == AXIS_AUTO1 || cfg.tiltMode == AXIS_AUTO2) && tiltMenuIndex == 3) {
-        if (nav == NAV_LEFT)  cfg.tiltMax = clampFloat(cfg.tiltMax - 0.05f, cfg.tiltMin + 0.05f, 1.0f);
-        if (nav == NAV_RIGHT) cfg.tiltMax = clampFloat(cfg.tiltMax + 0.05f, cfg.tiltMin + 0.05f, 1.0f);
+        if (nav == NAV_LEFT)  cfg.tiltMax = q16Clamp(cfg.tiltMax - Q16(0.05), cfg.tiltMin + Q16(0.05), Q16_ONE);
+        if (nav == NAV_RIGHT) cfg.tiltMax = q16Clamp(cfg.tiltMax + Q16(0.05), cfg.tiltMin + Q16(0.05), Q16_ONE);
       }
 
       if (cfg.tiltMode == AXIS_RANDOM && tiltMenuIndex == 1) {
-        if (nav == NAV_LEFT)  cfg.tiltMin = clampFloat(cfg.tiltMin - 0.05f, -1.0f, cfg.tiltMax - 0.05f);
-        if (nav == NAV_RIGHT) cfg.tiltMin = clampFloat(cfg.tiltMin + 0.05f, -1.0f, cfg.tiltMax - 0.05f);
+        if (nav == NAV_LEFT)  cfg.tiltMin = q16Clamp(cfg.tiltMin - Q16(0.05), -Q16_ONE, cfg.tiltMax - Q16(0.05));
+        if (nav == NAV_RIGHT) cfg.tiltMin = q16Clamp(cfg.tiltMin + Q16(0.05), -Q16_ONE, cfg.tiltMax - Q16(0.05));
       }
       if (cfg.tiltMode == AXIS_RANDOM && tiltMenuIndex == 2) {
-        if (nav == NAV_LEFT)  cfg.tiltMax = clampFloat(cfg.tiltMax - 0.05f, cfg.tiltMin + 0.05f, 1.0f);
-        if (nav == NAV_RIGHT) cfg.tiltMax = clampFloat(cfg.tiltMax + 0.05f, cfg.tiltMin + 0.05f, 1.0f);
+        if (nav == NAV_LEFT)  cfg.tiltMax = q16Clamp(cfg.tiltMax - Q16(0.05), cfg.tiltMin + Q16(0.05), Q16_ONE);
+        if (nav == NAV_RIGHT) cfg.tiltMax = q16Clamp(cfg.tiltMax + Q16(0.05), cfg.tiltMin + Q16(0.05), Q16_ONE);
       }
       if (cfg.tiltMode == AXIS_RANDOM && tiltMenuIndex == 3) {
         if (nav == NAV_LEFT)  cfg.tiltRandomPauseMs = (unsigned long)clampInt((int)(cfg.tiltRandomPauseMs - 250), 500, 10000);
@@ -311,31 +354,21 @@ void loop() {
         }
       }
 
-      renderAxisMenu("TILT", cfg.tiltMode, cfg.tiltTarget, tiltMenuIndex);
+      renderAxisMenu(false, cfg.tiltMode, cfg.tiltTarget, tiltMenuIndex);
       break;
     }
 
     case SCREEN_PAN_EDIT: {
-      float stickX = joyToNorm(analogRead(JOY_X));
-      applyIncremental(cfg.panTarget, stickX);
-
-      // Atualizar servos em tempo real durante edição
-      updateServos(cfg.panTarget, cfg.tiltTarget);
-
+      // Alvo e servos são atualizados no tick de controle (updateAxisPreviewTargets)
       if (swPressedEvent) currentScreen = SCREEN_PAN;
-      renderAxisEdit("PAN", cfg.panTarget);
+      renderAxisEdit(true, cfg.panTarget);
       break;
     }
 
     case SCREEN_TILT_EDIT: {
-      float stickY = joyToNorm(analogRead(JOY_Y));
-      applyIncremental(cfg.tiltTarget, stickY);
-
-      // Atualizar servos em tempo real durante edição
-      updateServos(cfg.panTarget, cfg.tiltTarget);
-
+      // Alvo e servos são atualizados no tick de controle (updateAxisPreviewTargets)
       if (swPressedEvent) currentScreen = SCREEN_TILT;
-      renderAxisEdit("TILT", cfg.tiltTarget);
+      renderAxisEdit(false, cfg.tiltTarget);
       break;
     }
 
@@ -380,15 +413,15 @@ void loop() {
     }
 
     case SCREEN_FEEDER: {
-      int feederMaxIndex = (cfg.feederMode == FEED_CUSTOM) ? 4 : 2;
-      if (nav == NAV_UP) feederIndex = clampInt(feederIndex - 1, 0, feederMaxIndex);
-      if (nav == NAV_DOWN) feederIndex = clampInt(feederIndex + 1, 0, feederMaxIndex);
+      int feederLast = feederMaxIndex(cfg.feederMode);
+      if (nav == NAV_UP) feederIndex = clampInt(feederIndex - 1, 0, feederLast);
+      if (nav == NAV_DOWN) feederIndex = clampInt(feederIndex + 1, 0, feederLast);
 
       if (feederIndex == 0) {
         if (nav == NAV_LEFT)  cfg.feederMode = (FeederMode)((cfg.feederMode + FEED_MODE_COUNT - 1) % FEED_MODE_COUNT);
         if (nav == NAV_RIGHT) cfg.feederMode = (FeederMode)((cfg.feederMode + 1) % FEED_MODE_COUNT);
-        feederMaxIndex = (cfg.feederMode == FEED_CUSTOM) ? 4 : 2;
-        if (feederIndex > feederMaxIndex) feederIndex = feederMaxIndex;
+        feederLast = feederMaxIndex(cfg.feederMode);
+        if (feederIndex > feederLast) feederIndex = feederLast;
       }
 
       if (feederIndex == 1) {
@@ -407,8 +440,13 @@ void loop() {
         }
       }
 
+      if (cfg.feederMode == FEED_BPM && feederIndex == 2) {
+        if (nav == NAV_LEFT)  cfg.feederBpm = clampInt(cfg.feederBpm - 5, 10, 120);
+        if (nav == NAV_RIGHT) cfg.feederBpm = clampInt(cfg.feederBpm + 5, 10, 120);
+      }
+
       if (swPressedEvent) {
-        if (feederIndex == feederMaxIndex) goBackToWizard();
+        if (feederIndex == feederLast) goBackToWizard();
       }
 
       renderFeeder();
@@ -416,16 +454,22 @@ void loop() {
     }
 
     case SCREEN_TIMER: {
-      if (nav == NAV_UP) timerMenuIndex = clampInt(timerMenuIndex - 1, 0, 1);
-      if (nav == NAV_DOWN) timerMenuIndex = clampInt(timerMenuIndex + 1, 0, 1);
+      if (nav == NAV_UP) timerMenuIndex = clampInt(timerMenuIndex - 1, 0, 2);
+      if (nav == NAV_DOWN) timerMenuIndex = clampInt(timerMenuIndex + 1, 0, 2);
 
       if (timerMenuIndex == 0) {
         if (nav == NAV_LEFT)  cfg.timerIndex = clampInt(cfg.timerIndex - 1, 0, 5);
         if (nav == NAV_RIGHT) cfg.timerIndex = clampInt(cfg.timerIndex + 1, 0, 5);
       }
 
+      // Ball limit: OFF, then steps of 10 balls
+      if (timerMenuIndex == 1) {
+        if (nav == NAV_LEFT)  cfg.ballLimit = clampInt(cfg.ballLimit - 10, 0, 990);
+        if (nav == NAV_RIGHT) cfg.ballLimit = clampInt(cfg.ballLimit + 10, 0, 990);
+      }
+
       if (swPressedEvent) {
-        if (timerMenuIndex == 1) goBackToWizard();
+        if (timerMenuIndex == 2) goBackToWizard();
       }
 
       renderTimer();
@@ -449,4 +493,10 @@ void loop() {
       break;
     }
   }
+
+  profMark(PROF_UI);
+  // Second chance after the UI so a slow frame push delays the next tick as little as possible
+  runControlTicks();
+  profMark(PROF_CONTROL);
+  txDrain();  // refill the UARTs after a long UI frame
 }
@@ -0,0 +1,143 @@
+#include "profiler.h"
+#include "flash_str.h"
+
+#if LOOP_PROFILER
+
+struct ProfHistogram {
+  uint16_t buckets[PROF_BUCKETS];
+  unsigned long count;
+  unsigned long minUs;
+  unsigned long maxUs;
+};
+
+static ProfHistogram profHist[PROF_STAGE_COUNT];
+static unsigned long profStageStartUs = 0;
+static unsigned long profLoopStartUs = 0;
+static bool profLoopStarted = false;
+
+static const char PROF_NAME_BT_IN[] PROGMEM = "bt_in";
+static const char PROF_NAME_BT_STATE[] PROGMEM = "bt_state";
+static const char PROF_NAME_BUTTON[] PROGMEM = "button";
+static const char PROF_NAME_CONTROL[] PROGMEM = "control";
+static const char PROF_NAME_UI[] PROGMEM = "ui";
+static const char PROF_NAME_LOOP[] PROGMEM = "loop";
+static const char* const PROF_STAGE_NAMES[PROF_STAGE_COUNT] PROGMEM = {
+  PROF_NAME_BT_IN, PROF_NAME_BT_STATE, PROF_NAME_BUTTON, PROF_NAME_CONTROL, PROF_NAME_UI, PROF_NAME_LOOP
+};
+
+// Bucket 0 = 0..3 us; then two buckets per octave: [2^k, 1.5*2^k) and [1.5*2^k, 2^(k+1)).
+// The last bucket also holds everything above ~131 ms.
+static uint8_t profBucketFor(unsigned long us) {
+  if (us < 4) return 0;
+  uint8_t octave = 0;
+  for (unsigned long v = us; v >= 2; v >>= 1) octave++;
+  uint8_t half = (uint8_t)((us >> (octave - 1)) & 1UL);
+  int b = 1 + (octave - 2) * 2 + half;
+  if (b >= PROF_BUCKETS) b = PROF_BUCKETS - 1;
+  return (uint8_t)b;
+}
+
+static unsigned long profBucketUpperUs(uint8_t b) {
+  if (b == 0) return 3;
+  uint8_t octave = 2 + (b - 1) / 2;
+  uint8_t half = (b - 1) % 2;
+  unsigned long lower = (1UL << octave) + (half ? (1UL << (octave - 1)) : 0UL);
+  return lower + (1UL << (octave - 1)) - 1;
+}
+
+void profReset() {
+  for (int s = 0; s < PROF_STAGE_COUNT; s++) {
+    for (int b = 0; b < PROF_BUCKETS; b++) profHist[s].buckets[b] = 0;
+    profHist[s].count = 0;
+    profHist[s].minUs = 0xFFFFFFFFUL;
+    profHist[s].maxUs = 0;
+  }
+  profLoopStarted = false;
+}
+
+void profRecord(ProfStage stage, unsigned long us) {
+  if (stage >= PROF_STAGE_COUNT) return;
+  ProfHistogram &h = profHist[stage];
+  if (h.count == 0) h.minUs = 0xFFFFFFFFUL;
+
+  uint8_t b = profBucketFor(us);
+  if (h.buckets[b] == 0xFFFF) {
+    // Saturated: halve the whole histogram so the shape (and percentiles) survive long runs.
+    for (int i = 0; i < PROF_BUCKETS; i++) h.buckets[i] >>= 1;
+  }
+  h.buckets[b]++;
+  h.count++;
+  if (us < h.minUs) h.minUs = us;
+  if (us > h.maxUs) h.maxUs = us;
+}
+
+void profLoopBegin() {
+  unsigned long now = micros();
+  if (profLoopStarted) profRecord(PROF_LOOP, now - profLoopStartUs);
+  profLoopStarted = true;
+  profLoopStartUs = now;
+  profStageStartUs = now;
+}
+
+void profMark(ProfStage stage) {
+  unsigned long now = micros();
+  profRecord(stage, now - profStageStartUs);
+  profStageStartUs = now;
+}
+
+static unsigned long profPercentileUs(const ProfHistogram &h, unsigned long permille) {
+  unsigned long total = 0;
+  for (int b = 0; b < PROF_BUCKETS; b++) total += h.buckets[b];
+  if (total == 0) return 0;
+
+  unsigned long rank = (total * permille + 999UL) / 1000UL;
+  if (rank == 0) rank = 1;
+  unsigned long seen = 0;
+  for (uint8_t b = 0; b < PROF_BUCKETS; b++) {
+    seen += h.buckets[b];
+    if (seen >= rank) {
+      unsigned long upper = profBucketUpperUs(b);
+      if (upper > h.maxUs) upper = h.maxUs;
+      if (upper < h.minUs) upper = h.minUs;
+      return upper;
+    }
+  }
+  return h.maxUs;
+}
+
+void profGetStats(ProfStage stage, ProfStats &out) {
+  const ProfHistogram &h = profHist[stage];
+  out.count = h.count;
+  out.minUs = h.count ? h.minUs : 0;
+  out.p50Us = profPercentileUs(h, 500);
+  out.p99Us = profPercentileUs(h, 990);
+  out.maxUs = h.maxUs;
+}
+
+const __FlashStringHelper* profStageName(ProfStage stage) {
+  if (stage >= PROF_STAGE_COUNT) return F("?");
+  return flashStr(PROF_STAGE_NAMES, (uint8_t)stage);
+}
+
+// One line per stage: <prefix><name>,<count>,<min>,<p50>,<p99>,<max> (all in us).
+void profDump(Print &out, const __FlashStringHelper* prefix) {
+  for (int s = 0; s < PROF_STAGE_COUNT; s++) {
+    ProfStats st;
+    profGetStats((ProfStage)s, st);
+    out.print(prefix);
+    out.print(profStageName((ProfStage)s));
+    out.print(',');
+    out.print(st.count);
+    out.print(',');
+    out.print(st.minUs);
+    out.print(',');
+    out.print(st.p50Us);
+    out.print(',');
+    out.print(st.p99Us);
+    out.print(',');
+    out.print(st.maxUs);
+    out.print('\n');
+  }
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+#include <Arduino.h>
+
+// Loop profiler: micros() deltas per loop() stage go into fixed-size log histograms in a static
+// buffer (no heap). Each histogram bucket is half an octave wide, so p50/p99 are reported as the
+// upper edge of the bucket that contains them (at most ~41% above the true value); min and max
+// are exact. Dump with BT "T" (to the app), "T,S" (to Serial) or reset with "T,R".
+
+#ifndef LOOP_PROFILER
+#define LOOP_PROFILER 1  // -DLOOP_PROFILER=0 compiles it out
+#endif
+
+enum ProfStage {
+  PROF_BT_INPUT = 0,   // processBTInput() + updateTelemetry() + txDrain()
+  PROF_BT_STATE,       // updateBTState()
+  PROF_BUTTON,         // updateButton()
+  PROF_CONTROL,        // runControlTicks(): aim, servos and motors (0..CONTROL_MAX_CATCHUP ticks)
+  PROF_UI,             // readNavEvent() + screen switch + render*()
+  PROF_LOOP,           // full loop() period
+  PROF_STAGE_COUNT
+};
+
+#define PROF_BUCKETS 32
+
+struct ProfStats {
+  unsigned long count;
+  unsigned long minUs;
+  unsigned long p50Us;
+  unsigned long p99Us;
+  unsigned long maxUs;
+};
+
+#if LOOP_PROFILER
+
+void profLoopBegin();
+void profMark(ProfStage stage);
+void profRecord(ProfStage stage, unsigned long us);
+void profReset();
+void profGetStats(ProfStage stage, ProfStats &out);
+const __FlashStringHelper* profStageName(ProfStage stage);
+void profDump(Print &out, const __FlashStringHelper* prefix);
+
+#else
+
+inline void profLoopBegin() {}
+inline void profMark(ProfStage) {}
+inline void profRecord(ProfStage, unsigned long) {}
+inline void profReset() {}
+inline void profGetStats(ProfStage, ProfStats &out) { out = ProfStats{ 0, 0, 0, 0, 0 }; }
+inline const __FlashStringHelper* profStageName(ProfStage) { return F(""); }
+inline void profDump(Print &, const __FlashStringHelper*) {}
+
+#endif
+
+#endif
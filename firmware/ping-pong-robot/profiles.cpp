@@ -0,0 +1,192 @@
+#include "profiles.h"
+#include "bt_command.h"
+#include "bt_frame.h"
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+#include <string.h>
+
+// Record layout (profiles.h)
+#define REC_SLOT   1
+#define REC_SEQ    2
+#define REC_NAME   6
+#define REC_CONFIG (REC_NAME + PROFILE_NAME_LEN)
+#define REC_CRC    (REC_CONFIG + CONFIG_PACKED_LEN)
+#define PROFILE_RECORD_LEN (REC_CRC + 2)  // 66 bytes: 61 records in the 4 KB EEPROM
+#define NO_RECORD  0xFF
+
+struct ProfileSlot {
+  uint8_t record;      // ring index of the live record, NO_RECORD when empty
+  uint16_t configCrc;  // CRC of its CONFIG bytes, so profileAutosave() can skip an unchanged cfg
+  char name[PROFILE_NAME_LEN + 1];
+};
+
+static ProfileSlot slots[PROFILE_SLOTS + 1];
+static uint8_t recordCount = 0;
+static uint8_t nextRecord = 0;  // ring position after the newest record
+static uint32_t nextSeq = 1;
+
+// Save in progress: written out by profilesPoll()
+static uint8_t pendBuf[PROFILE_RECORD_LEN];
+static uint8_t pendPos = 0;
+static uint8_t pendRecord = NO_RECORD;
+static int8_t pendSlot = -1;
+
+static int recordAddr(uint8_t r) {
+  return PROFILE_LOG_START + (int)r * PROFILE_RECORD_LEN;
+}
+
+static uint16_t crcOf(const uint8_t* p, uint8_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) crc = crc16Ccitt(crc, *p++);
+  return crc;
+}
+
+static uint32_t readU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Ring record r into buf; false if erased, torn by a power loss, or of another layout version
+static bool readRecord(uint8_t r, uint8_t* buf) {
+  const int addr = recordAddr(r);
+  for (uint8_t i = 0; i < PROFILE_RECORD_LEN; i++) buf[i] = EEPROM.read(addr + i);
+  if (buf[0] != PROFILE_LAYOUT_VERSION || buf[REC_SLOT] > PROFILE_SLOTS) return false;
+  const uint16_t crc = (uint16_t)buf[REC_CRC] | ((uint16_t)buf[REC_CRC + 1] << 8);
+  return crc == crcOf(buf, REC_CRC);
+}
+
+static void setSlot(uint8_t slot, uint8_t record, const uint8_t* buf) {
+  slots[slot].record = record;
+  slots[slot].configCrc = crcOf(buf + REC_CONFIG, CONFIG_PACKED_LEN);
+  memcpy(slots[slot].name, buf + REC_NAME, PROFILE_NAME_LEN);
+  slots[slot].name[PROFILE_NAME_LEN] = '\0';
+}
+
+static bool isLive(uint8_t r) {
+  for (uint8_t s = 0; s <= PROFILE_SLOTS; s++) {
+    if (slots[s].record == r) return true;
+  }
+  return false;
+}
+
+void initProfiles() {
+  recordCount = (uint8_t)((EEPROM.length() - PROFILE_LOG_START) / PROFILE_RECORD_LEN);
+  for (uint8_t s = 0; s <= PROFILE_SLOTS; s++) {
+    slots[s].record = NO_RECORD;
+    slots[s].name[0] = '\0';
+  }
+
+  uint32_t slotSeq[PROFILE_SLOTS + 1];
+  uint32_t newest = 0;
+  bool any = false;
+  uint8_t buf[PROFILE_RECORD_LEN];
+  for (uint8_t r = 0; r < recordCount; r++) {
+    if (!readRecord(r, buf)) continue;
+    const uint8_t slot = buf[REC_SLOT];
+    const uint32_t seq = readU32(buf + REC_SEQ);
+    if (slots[slot].record == NO_RECORD || seq > slotSeq[slot]) {
+      slotSeq[slot] = seq;
+      setSlot(slot, r, buf);
+    }
+    if (!any || seq > newest) {
+      newest = seq;
+      nextRecord = (uint8_t)((r + 1) % recordCount);
+      any = true;
+    }
+  }
+  nextSeq = any ? newest + 1 : 1;
+
+  profileLoad(PROFILE_LAST);
+}
+
+void profilesPoll() {
+  if (pendSlot < 0) return;
+  // update() skips bytes that already hold the value; a real write keeps the EEPROM busy ~3.4 ms
+  const int addr = recordAddr(pendRecord);
+  while (pendPos < PROFILE_RECORD_LEN && eeprom_is_ready()) {
+    EEPROM.update(addr + pendPos, pendBuf[pendPos]);
+    pendPos++;
+  }
+  if (pendPos < PROFILE_RECORD_LEN) return;
+
+  setSlot((uint8_t)pendSlot, pendRecord, pendBuf);
+  nextRecord = (uint8_t)((pendRecord + 1) % recordCount);
+  pendSlot = -1;
+}
+
+static bool beginSave(uint8_t slot, const char* name, const uint8_t* packed) {
+  if (pendSlot >= 0 || recordCount == 0) return false;
+
+  uint32_t seq = nextSeq++;
+  pendBuf[0] = PROFILE_LAYOUT_VERSION;
+  pendBuf[REC_SLOT] = slot;
+  for (uint8_t i = 0; i < 4; i++, seq >>= 8) pendBuf[REC_SEQ + i] = (uint8_t)(seq & 0xFF);
+  memset(pendBuf + REC_NAME, 0, PROFILE_NAME_LEN);
+  for (uint8_t i = 0; i < PROFILE_NAME_LEN && name[i] != '\0'; i++) {
+    const char c = name[i];
+    pendBuf[REC_NAME + i] = (c < ' ' || c > '~' || c == ',') ? '_' : c;  // listed as L,<name>,...
+  }
+  memcpy(pendBuf + REC_CONFIG, packed, CONFIG_PACKED_LEN);
+  const uint16_t crc = crcOf(pendBuf, REC_CRC);
+  pendBuf[REC_CRC] = (uint8_t)(crc & 0xFF);
+  pendBuf[REC_CRC + 1] = (uint8_t)(crc >> 8);
+
+  // Oldest record that is no slot's live copy; there are far more records than slots
+  uint8_t r = nextRecord;
+  while (isLive(r)) r = (uint8_t)((r + 1) % recordCount);
+  pendRecord = r;
+  pendPos = 0;
+  pendSlot = (int8_t)slot;
+  return true;
+}
+
+bool profileSave(uint8_t slot, const char* name) {
+  if (slot < 1 || slot > PROFILE_SLOTS) return false;
+  char fallback[PROFILE_NAME_LEN + 1];
+  if (name[0] == '\0') {
+    if (slots[slot].record != NO_RECORD) {
+      strcpy(fallback, slots[slot].name);
+    } else {
+      strcpy_P(fallback, PSTR("Profile "));
+      fallback[8] = (char)('0' + slot);
+      fallback[9] = '\0';
+    }
+    name = fallback;
+  }
+  uint8_t packed[CONFIG_PACKED_LEN];
+  packConfig(packed);
+  return beginSave(slot, name, packed);
+}
+
+void profileAutosave() {
+  uint8_t packed[CONFIG_PACKED_LEN];
+  packConfig(packed);
+  if (slots[PROFILE_LAST].record != NO_RECORD &&
+      slots[PROFILE_LAST].configCrc == crcOf(packed, CONFIG_PACKED_LEN)) {
+    return;
+  }
+  char name[PROFILE_NAME_LEN + 1];
+  strncpy_P(name, PSTR("Last"), sizeof(name));
+  beginSave(PROFILE_LAST, name, packed);  // skipped if a save is still being written
+}
+
+bool profileLoad(uint8_t slot) {
+  if (slot > PROFILE_SLOTS || slots[slot].record == NO_RECORD) return false;
+  uint8_t buf[PROFILE_RECORD_LEN];
+  if (!readRecord(slots[slot].record, buf)) return false;
+  int v[BT_CONFIG_FIELDS];
+  unpackConfig(buf + REC_CONFIG, BT_CONFIG_FIELDS, v);
+  applyStoredConfig(v);
+  return true;
+}
+
+bool profileUsed(uint8_t slot) {
+  return slot <= PROFILE_SLOTS && slots[slot].record != NO_RECORD;
+}
+
+const char* profileName(uint8_t slot) {
+  return slot <= PROFILE_SLOTS ? slots[slot].name : "";
+}
+
+int8_t profileSaving() {
+  return pendSlot;
+}
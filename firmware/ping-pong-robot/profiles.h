@@ -0,0 +1,40 @@
+#ifndef PROFILES_H
+#define PROFILES_H
+
+#include <Arduino.h>
+
+// Named config profiles in EEPROM. Slots 1..PROFILE_SLOTS are saved from the PROFILES screen or
+// W,<slot>,<name>; slot 0 (PROFILE_LAST) is the config of the last run, saved at START when it
+// changed and loaded at boot, so a power cycle keeps the settings.
+//
+// Every save appends one record to a ring log (PROFILE_LOG_START..end of EEPROM); the newest
+// valid record of a slot wins. Records that are still the live copy of a slot are skipped when the
+// ring wraps, so repeated saves spread over all the other records instead of wearing one set of
+// cells. Record layout (multi-byte values little-endian):
+//   VER(PROFILE_LAYOUT_VERSION) SLOT SEQ(u32) NAME[PROFILE_NAME_LEN] CONFIG[CONFIG_PACKED_LEN] CRC16
+// CONFIG is the BT_FRAME_CONFIG payload (bt_frame.h); CRC16 is crc16Ccitt over VER..CONFIG. A save
+// cut short by a power loss fails its CRC and the slot's previous record stays in use.
+//
+// Saves return at once; profilesPoll() programs one byte whenever the EEPROM is ready (~3.4 ms
+// each), so a save never stalls the control tick.
+
+#define PROFILE_SLOTS          4
+#define PROFILE_LAST           0
+#define PROFILE_NAME_LEN       10
+#define PROFILE_LAYOUT_VERSION 1
+#define PROFILE_LOG_START      64  // bytes below are servo limits and calibration (servos.cpp) and the HM-10 rate (bt_at.cpp)
+
+void initProfiles();  // scans the log; loads PROFILE_LAST into cfg when there is one
+void profilesPoll();  // every loop()
+
+// Starts writing cfg to slot (1..PROFILE_SLOTS). An empty name keeps the slot's name, or
+// "Profile <n>" for a new slot. False if the slot is out of range or a save is still in progress.
+bool profileSave(uint8_t slot, const char* name);
+void profileAutosave();          // at START: cfg to PROFILE_LAST when it differs from the stored copy
+bool profileLoad(uint8_t slot);  // stored config -> cfg (applyStoredConfig); false if the slot is empty
+
+bool profileUsed(uint8_t slot);
+const char* profileName(uint8_t slot);  // "" for an empty slot
+int8_t profileSaving();                 // slot being written, -1 when idle
+
+#endif
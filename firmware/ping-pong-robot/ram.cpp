@@ -0,0 +1,89 @@
+#include "ram.h"
+
+#define RAM_CANARY 0xC5
+
+#ifdef __AVR__
+
+extern uint8_t __data_start;  // start of .data (bottom of SRAM)
+extern uint8_t _end;          // end of .bss = __heap_start
+extern uint8_t __stack;       // RAMEND
+extern char* __brkval;        // malloc() break, 0 until the first allocation
+
+// .init1 runs before __zero_reg__ and the stack pointer are set up, so this is plain asm that
+// only uses Z and r24/r25: _end..RAMEND = RAM_CANARY.
+void ramPaint() __attribute__((naked, used, section(".init1")));
+void ramPaint() {
+  __asm volatile(
+    "    ldi r30, lo8(_end)\n"
+    "    ldi r31, hi8(_end)\n"
+    "    ldi r24, %0\n"
+    "    ldi r25, hi8(__stack)\n"
+    "    rjmp 2f\n"
+    "1:  st Z+, r24\n"
+    "2:  cpi r30, lo8(__stack)\n"
+    "    cpc r31, r25\n"
+    "    brlo 1b\n"
+    "    breq 1b\n"
+    :
+    : "i"(RAM_CANARY));
+}
+
+static uint8_t* heapTop() {
+  return __brkval ? (uint8_t*)__brkval : &_end;
+}
+
+// Lowest byte the stack has written: first non-canary byte above the heap
+static uint8_t* stackLowWater() {
+  uint8_t* p = heapTop();
+  while (p <= &__stack && *p == RAM_CANARY) p++;
+  return p;
+}
+
+static uint8_t* ramLowWater = 0;  // stackLowWater() at the last ramScan()
+
+void ramScan() {
+  ramLowWater = stackLowWater();
+}
+
+uint16_t ramStaticBytes() {
+  return (uint16_t)(&_end - &__data_start);
+}
+
+uint16_t ramHeapBytes() {
+  return (uint16_t)(heapTop() - &_end);
+}
+
+uint16_t ramStackPeakBytes() {
+  if (!ramLowWater) ramScan();
+  return (uint16_t)(&__stack - ramLowWater + 1);
+}
+
+uint16_t ramHeadroomBytes() {
+  if (!ramLowWater) ramScan();
+  uint8_t* top = heapTop();
+  return ramLowWater > top ? (uint16_t)(ramLowWater - top) : 0;
+}
+
+#else
+
+void ramScan() {}
+uint16_t ramStaticBytes() { return 0; }
+uint16_t ramHeapBytes() { return 0; }
+uint16_t ramStackPeakBytes() { return 0; }
+uint16_t ramHeadroomBytes() { return 0; }
+
+#endif
+
+void ramReport(Print& out, const __FlashStringHelper* prefix) {
+  ramScan();
+  out.print(prefix);
+  out.print(F("static,"));
+  out.print(ramStaticBytes());
+  out.print(F(",heap,"));
+  out.print(ramHeapBytes());
+  out.print(F(",stack,"));
+  out.print(ramStackPeakBytes());
+  out.print(F(",free,"));
+  out.print(ramHeadroomBytes());
+  out.print('\n');
+}
@@ -0,0 +1,29 @@
+#ifndef RAM_H
+#define RAM_H
+
+#include <Arduino.h>
+
+// SRAM budget. At reset, before the C runtime starts, everything above .bss is painted with a
+// canary byte; the stack (growing down from RAMEND) and the heap (growing up from .bss) overwrite
+// it as they are used, so the canary bytes still left between them are the headroom that was never
+// touched. ramReport() lists that together with the static (.data + .bss) total; the per-symbol
+// breakdown of the static part is in the linker output (avr-nm --size-sort -S on the .elf).
+// Reported at boot on Serial, with BT "M" (to the app) / "M,S" (to Serial), and on the INFO screen.
+//
+// The scan walks the whole gap (up to ~6 KB), so it is for reports, not for every loop: ramScan()
+// runs it once and ramStackPeakBytes() / ramHeadroomBytes() return what it found. ramReport()
+// scans; the INFO screen scans when it is entered, not per frame. On the host build (simulator)
+// there is no AVR memory map and every figure is 0.
+
+#define RAM_TOTAL 8192  // ATmega2560 SRAM
+
+void ramScan();                // find the stack low-water mark (the slow part)
+uint16_t ramStaticBytes();     // .data + .bss
+uint16_t ramHeapBytes();       // malloc() arena in use (0: nothing allocates)
+uint16_t ramStackPeakBytes();  // deepest stack since reset, as of the last ramScan()
+uint16_t ramHeadroomBytes();   // never touched by the stack or the heap, as of the last ramScan()
+
+// prefix,static,<n>,heap,<n>,stack,<n>,free,<n>
+void ramReport(Print& out, const __FlashStringHelper* prefix);
+
+#endif
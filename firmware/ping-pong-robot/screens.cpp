@@ -5,453 +5,540 @@
 #include "motors.h"
 #include "servos.h"
 #include "bt_command.h"
+#include "drill.h"
+#include "profiles.h"
+#include "ram.h"
+#include "flash_str.h"
 #include <Arduino.h>
 #include <stdio.h>
 
-void renderHome() {
-  display.clearDisplay();
-  drawHeader("HOME");
+// Menu tables (flash_str.h)
+static const char HOME_WIZARD[] PROGMEM = "Start Wizard";
+static const char HOME_PROFILES[] PROGMEM = "Profiles";
+static const char HOME_INFO[] PROGMEM = "Info / Stats";
+static const char HOME_SETTINGS[] PROGMEM = "Settings";
+static const char* const HOME_ITEMS[] PROGMEM = { HOME_WIZARD, HOME_PROFILES, HOME_INFO, HOME_SETTINGS };
+
+static const char WIZARD_PAN[] PROGMEM = "Pan";
+static const char WIZARD_TILT[] PROGMEM = "Tilt";
+static const char WIZARD_LAUNCHER[] PROGMEM = "Launcher";
+static const char WIZARD_FEEDER[] PROGMEM = "Feeder";
+static const char WIZARD_TIMER[] PROGMEM = "Timer";
+static const char WIZARD_START[] PROGMEM = "START";
+static const char* const WIZARD_ITEMS[] PROGMEM = {
+  WIZARD_PAN, WIZARD_TILT, WIZARD_LAUNCHER, WIZARD_FEEDER, WIZARD_TIMER, WIZARD_START
+};
 
-  const char* items[3] = { "Start Wizard", "Info / Stats", "Settings" };
+// Índices: 0=Servo1, 1=Servo2, 2=M1, 3=M2, 4=M3, 5=M4, 6=Back
+#define SETTINGS_ITEMS 7
+#define SETTINGS_VISIBLE 4
 
-  for (int i = 0; i < 3; i++) {
-    display.setCursor(0, BODY_Y + i * 12);
-    display.print(i == homeIndex ? "> " : "  ");
-    display.println(items[i]);
-  }
+static const char SETTINGS_SERVO1[] PROGMEM = "Servo 1";
+static const char SETTINGS_SERVO2[] PROGMEM = "Servo 2";
+static const char SETTINGS_M1[] PROGMEM = "M1";
+static const char SETTINGS_M2[] PROGMEM = "M2";
+static const char SETTINGS_M3[] PROGMEM = "M3";
+static const char SETTINGS_M4[] PROGMEM = "M4";
+static const char SETTINGS_BACK[] PROGMEM = "Back";
+static const char* const SETTINGS_LABELS[SETTINGS_ITEMS] PROGMEM = {
+  SETTINGS_SERVO1, SETTINGS_SERVO2, SETTINGS_M1, SETTINGS_M2, SETTINGS_M3, SETTINGS_M4, SETTINGS_BACK
+};
 
-  display.setCursor(0, 56);
-  display.print("SW=Select");
+void renderHome() {
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("HOME"));
+
+    for (int i = 0; i < 4; i++) {
+      display.setCursor(0, BODY_Y + i * 10);
+      drawMarker(i == homeIndex);
+      display.println(flashStr(HOME_ITEMS, (uint8_t)i));
+    }
 
-  display.display();
+    display.setCursor(0, 56);
+    display.print(F("SW=Select"));
+  } while (nextPage());
 }
 
-void renderInfo() {
-  display.clearDisplay();
-  drawHeader("INFO");
-
-  display.setCursor(0, BODY_Y);
-  display.println("PingPong Bot UI v5");
-
-  display.setCursor(0, BODY_Y + 12);
-  display.print("Max played: ");
-  display.print(maxPlayedMs / 1000);
-  display.println("s");
-
-  display.setCursor(0, BODY_Y + 24);
-  display.print("BT: ");
-  display.println(getBtConnected() ? "Connected" : "Off");
-  const char* name = getBtDeviceName();
-  if (getBtConnected()) {
-    display.setCursor(0, BODY_Y + 36);
-    display.println(name[0] != '\0' ? name : "Unknown");
-  }
+void renderProfiles() {
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("PROFILES"));
 
-  display.display();
+    display.setCursor(0, BODY_Y);
+    drawMarker(profileMenuIndex == 0);
+    display.print(F("Action: "));
+    display.print(profileSaveMode ? F("Save") : F("Load"));
+
+    const int8_t saving = profileSaving();
+    for (uint8_t s = 1; s <= PROFILE_SLOTS; s++) {
+      display.setCursor(0, BODY_Y + s * 8);
+      drawMarker(profileMenuIndex == s);
+      display.print(s);
+      display.print(' ');
+      if (profileUsed(s)) display.print(profileName(s));
+      else display.print('-');
+      if (saving == (int8_t)s) display.print(F(" ..."));
+    }
+
+    display.setCursor(0, BODY_Y + (PROFILE_SLOTS + 1) * 8);
+    drawMarker(profileMenuIndex == PROFILE_SLOTS + 1);
+    display.print(F("Back"));
+  } while (nextPage());
 }
 
-void renderWizard() {
-  display.clearDisplay();
-  drawHeader("WIZARD");
+void renderInfo() {
+  if (!beginFrame(currentScreen)) return;
 
-  const char* items[6] = { "Pan", "Tilt", "Launcher", "Feeder", "Timer", "START" };
+  // As of the ramScan() on entering the screen: the scan is too slow for every frame
+  const uint16_t ramFree = ramHeadroomBytes();
+  const uint16_t ramStack = ramStackPeakBytes();
 
-  for (int i = 0; i < 6; i++) {
-    display.setCursor(0, BODY_Y + i * 8);
-    display.print(i == wizardIndex ? "> " : "  ");
-    display.print(items[i]);
+  do {
+    drawHeader(F("INFO"));
 
-    if (i == 0) { display.setCursor(80, BODY_Y + i * 8); display.print(axisModeName(cfg.panMode)); }
-    if (i == 1) { display.setCursor(80, BODY_Y + i * 8); display.print(axisModeName(cfg.tiltMode)); }
-    if (i == 2) { display.setCursor(80, BODY_Y + i * 8); display.print(cfg.launcherPower); }
-    if (i == 3) { display.setCursor(80, BODY_Y + i * 8); display.print(cfg.feederSpeed); }
-    if (i == 4) { display.setCursor(80, BODY_Y + i * 8); display.print(timerNameByIndex(cfg.timerIndex)); }
-  }
+    display.setCursor(0, BODY_Y);
+    display.println(F("PingPong Bot UI v5"));
+
+    display.setCursor(0, BODY_Y + 10);
+    display.print(F("Max played: "));
+    display.print(maxPlayedMs / 1000);
+    display.println('s');
+
+    display.setCursor(0, BODY_Y + 20);
+    display.print(F("BT: "));
+    display.println(getBtConnected() ? F("Connected") : F("Off"));
+    const char* name = getBtDeviceName();
+    if (getBtConnected()) {
+      display.setCursor(0, BODY_Y + 30);
+      if (name[0] != '\0') display.println(name);
+      else display.println(F("Unknown"));
+    }
 
-  display.display();
+    display.setCursor(0, BODY_Y + 40);
+    display.print(F("RAM free:"));
+    display.print(ramFree);
+    display.print(F(" stk:"));
+    display.print(ramStack);
+  } while (nextPage());
+}
+
+void renderWizard() {
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("WIZARD"));
+
+    for (int i = 0; i < 6; i++) {
+      display.setCursor(0, BODY_Y + i * 8);
+      drawMarker(i == wizardIndex);
+      display.print(flashStr(WIZARD_ITEMS, (uint8_t)i));
+
+      if (i == 0) { display.setCursor(80, BODY_Y + i * 8); display.print(axisModeName(cfg.panMode)); }
+      if (i == 1) { display.setCursor(80, BODY_Y + i * 8); display.print(axisModeName(cfg.tiltMode)); }
+      if (i == 2) { display.setCursor(80, BODY_Y + i * 8); display.print(cfg.launcherPower); }
+      if (i == 3) { display.setCursor(80, BODY_Y + i * 8); display.print(cfg.feederSpeed); }
+      if (i == 4) { display.setCursor(80, BODY_Y + i * 8); display.print(timerNameByIndex(cfg.timerIndex)); }
+    }
+  } while (nextPage());
 }
 
 #define AXIS_LINE_H   12
 #define AXIS_VISIBLE  4
 
-void renderAxisMenu(const char* title, AxisMode mode, float targetValue, int menuIndex) {
-  display.clearDisplay();
-  drawHeader(title);
-
-  float pan = (title[0] == 'P') ? targetValue : cfg.panTarget;
-  float tilt = (title[0] == 'T') ? targetValue : cfg.tiltTarget;
-  drawMiniRadarWithLimits(92, BODY_Y, 32, pan, tilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
-
-  bool isPan = (title[0] == 'P');
-  int totalItems = (mode == AXIS_RANDOM || mode == AXIS_AUTO1 || mode == AXIS_AUTO2) ? 5 : (axisHasSecondOption(mode) ? 3 : 2);
-  int scrollOffset = 0;
-  if (totalItems > AXIS_VISIBLE) {
-    scrollOffset = menuIndex - (AXIS_VISIBLE - 1);
-    if (scrollOffset < 0) scrollOffset = 0;
-    if (scrollOffset > totalItems - AXIS_VISIBLE) scrollOffset = totalItems - AXIS_VISIBLE;
-  }
+void renderAxisMenu(bool isPan, AxisMode mode, q16_t targetValue, int menuIndex) {
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(isPan ? F("PAN") : F("TILT"));
+
+    q16_t pan = isPan ? targetValue : cfg.panTarget;
+    q16_t tilt = isPan ? cfg.tiltTarget : targetValue;
+    drawMiniRadarWithLimits(92, BODY_Y, 32, pan, tilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
+
+    int totalItems = (mode == AXIS_RANDOM || mode == AXIS_AUTO1 || mode == AXIS_AUTO2) ? 5 : (axisHasSecondOption(mode) ? 3 : 2);
+    int scrollOffset = 0;
+    if (totalItems > AXIS_VISIBLE) {
+      scrollOffset = menuIndex - (AXIS_VISIBLE - 1);
+      if (scrollOffset < 0) scrollOffset = 0;
+      if (scrollOffset > totalItems - AXIS_VISIBLE) scrollOffset = totalItems - AXIS_VISIBLE;
+    }
 
-  for (int i = 0; i < AXIS_VISIBLE && (scrollOffset + i) < totalItems; i++) {
-    int idx = scrollOffset + i;
-    int y = BODY_Y + i * AXIS_LINE_H;
-    display.setCursor(0, y);
-    display.print(idx == menuIndex ? "> " : "  ");
-
-    if (idx == 0) {
-      display.print("Mode: ");
-      display.println(axisModeName(mode));
-    } else if (mode == AXIS_RANDOM) {
-      if (idx == 1) { display.print("Min: "); display.println(isPan ? cfg.panMin : cfg.tiltMin, 2); }
-      else if (idx == 2) { display.print("Max: "); display.println(isPan ? cfg.panMax : cfg.tiltMax, 2); }
-      else if (idx == 3) {
-        unsigned long pauseMs = isPan ? cfg.panRandomPauseMs : cfg.tiltRandomPauseMs;
-        display.print("Pause: ");
-        display.print((float)pauseMs / 1000.0f, 1);
-        display.println("s");
-      }
-      else { display.println("Back"); }
-    } else if (mode == AXIS_AUTO1 || mode == AXIS_AUTO2) {
-      if (idx == 1) {
+    for (int i = 0; i < AXIS_VISIBLE && (scrollOffset + i) < totalItems; i++) {
+      int idx = scrollOffset + i;
+      int y = BODY_Y + i * AXIS_LINE_H;
+      display.setCursor(0, y);
+      drawMarker(idx == menuIndex);
+
+      if (idx == 0) {
+        display.print(F("Mode: "));
+        display.println(axisModeName(mode));
+      } else if (mode == AXIS_RANDOM) {
+        if (idx == 1) { display.print(F("Min: ")); display.println(q16ToFloat(isPan ? cfg.panMin : cfg.tiltMin), 2); }
+        else if (idx == 2) { display.print(F("Max: ")); display.println(q16ToFloat(isPan ? cfg.panMax : cfg.tiltMax), 2); }
+        else if (idx == 3) {
+          unsigned long pauseMs = isPan ? cfg.panRandomPauseMs : cfg.tiltRandomPauseMs;
+          display.print(F("Pause: "));
+          display.print((float)pauseMs / 1000.0f, 1);
+          display.println('s');
+        }
+        else { display.println(F("Back")); }
+      } else if (mode == AXIS_AUTO1 || mode == AXIS_AUTO2) {
+        if (idx == 1) {
+          display.print(axisSecondLabel(mode));
+          display.print(F(": "));
+          if (mode == AXIS_AUTO1) display.println(q16ToFloat(isPan ? cfg.panAuto1Speed : cfg.tiltAuto1Speed), 3);
+          else display.println(q16ToFloat(isPan ? cfg.panAuto2Step : cfg.tiltAuto2Step), 2);
+        } else if (idx == 2) { display.print(F("Min: ")); display.println(q16ToFloat(isPan ? cfg.panMin : cfg.tiltMin), 2); }
+        else if (idx == 3) { display.print(F("Max: ")); display.println(q16ToFloat(isPan ? cfg.panMax : cfg.tiltMax), 2); }
+        else { display.println(F("Back")); }
+      } else if (axisHasSecondOption(mode) && idx == 1) {
         display.print(axisSecondLabel(mode));
-        display.print(": ");
-        if (mode == AXIS_AUTO1) display.println(isPan ? cfg.panAuto1Speed : cfg.tiltAuto1Speed, 3);
-        else display.println(isPan ? cfg.panAuto2Step : cfg.tiltAuto2Step, 2);
-      } else if (idx == 2) { display.print("Min: "); display.println(isPan ? cfg.panMin : cfg.tiltMin, 2); }
-      else if (idx == 3) { display.print("Max: "); display.println(isPan ? cfg.panMax : cfg.tiltMax, 2); }
-      else { display.println("Back"); }
-    } else if (axisHasSecondOption(mode) && idx == 1) {
-      display.print(axisSecondLabel(mode));
-      display.print(": ");
-      display.println();
-    } else {
-      display.println("Back");
+        display.print(F(": "));
+        display.println();
+      } else {
+        display.println(F("Back"));
+      }
     }
-  }
-
-  display.display();
+  } while (nextPage());
 }
 
-void renderAxisEdit(const char* title, float value) {
-  display.clearDisplay();
-  drawHeader(title);
-
-  float pan = (title[0] == 'P') ? value : cfg.panTarget;
-  float tilt = (title[0] == 'T') ? value : cfg.tiltTarget;
+void renderAxisEdit(bool isPan, q16_t value) {
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(isPan ? F("PAN") : F("TILT"));
 
-  drawMiniRadarWithLimits(SCREEN_WIDTH - 52 - 2, 12, 52, pan, tilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
+    q16_t pan = isPan ? value : cfg.panTarget;
+    q16_t tilt = isPan ? cfg.tiltTarget : value;
 
-  // Mostra o valor acima da label SW=OK
-  display.setCursor(0, 48);
-  display.print("v: ");
-  display.print(value, 2);
+    drawMiniRadarWithLimits(SCREEN_WIDTH - 52 - 2, 12, 52, pan, tilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
 
-  display.setCursor(0, 56);
-  display.print("SW=OK");
+    // Mostra o valor acima da label SW=OK
+    display.setCursor(0, 48);
+    display.print(F("v: "));
+    display.print(q16ToFloat(value), 2);
 
-  display.display();
+    display.setCursor(0, 56);
+    display.print(F("SW=OK"));
+  } while (nextPage());
 }
 
 void renderLauncher() {
-  display.clearDisplay();
-  drawHeader("LAUNCHER");
-
-  display.setCursor(0, BODY_Y);
-  display.print(launcherIndex == 0 ? "> " : "  ");
-  display.print("Power: ");
-  display.println(cfg.launcherPower);
-
-  display.setCursor(0, BODY_Y + 12);
-  display.print(launcherIndex == 1 ? "> " : "  ");
-  display.print("Spin Config");
-  
-  display.setCursor(0, BODY_Y + 24);
-  display.print(launcherIndex == 2 ? "> " : "  ");
-  display.println("Back");
-
-  display.display();
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("LAUNCHER"));
+
+    display.setCursor(0, BODY_Y);
+    drawMarker(launcherIndex == 0);
+    display.print(F("Power: "));
+    display.println(cfg.launcherPower);
+
+    display.setCursor(0, BODY_Y + 12);
+    drawMarker(launcherIndex == 1);
+    display.print(F("Spin Config"));
+
+    display.setCursor(0, BODY_Y + 24);
+    drawMarker(launcherIndex == 2);
+    display.println(F("Back"));
+  } while (nextPage());
 }
 
 void renderSpin() {
-  display.clearDisplay();
-  drawHeader("SPIN");
-
-  display.setCursor(0, BODY_Y);
-  display.print(spinIndex == 0 ? "> " : "  ");
-  display.print("Direction: ");
-  display.println(spinModeName(cfg.spinMode));
-
-  display.setCursor(0, BODY_Y + 12);
-  display.print(spinIndex == 1 ? "> " : "  ");
-  display.print("Intensity: ");
-  display.println(cfg.spinIntensity);
-
-  display.setCursor(0, BODY_Y + 24);
-  display.print(spinIndex == 2 ? "> " : "  ");
-  display.println("Back");
-
-  // Visualizador de spin no canto direito
-  drawSpinVisualizer(92, BODY_Y, 32, cfg.spinMode);
-
-  // Mostra as potências dos motores na última linha (só se não for NONE)
-  if (cfg.spinMode != SPIN_NONE && cfg.spinIntensity > 0) {
-    int speed1, speed2, speed3;
-    getLauncherMotorSpeeds(cfg.launcherPower, cfg.spinMode, cfg.spinIntensity, speed1, speed2, speed3);
-    
-    display.setCursor(0, 56);
-    display.print("M1:");
-    display.print(speed1);
-    display.print(" M2:");
-    display.print(speed2);
-    display.print(" M3:");
-    display.print(speed3);
-  }
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("SPIN"));
 
-  display.display();
+    display.setCursor(0, BODY_Y);
+    drawMarker(spinIndex == 0);
+    display.print(F("Direction: "));
+    display.println(spinModeName(cfg.spinMode));
+
+    display.setCursor(0, BODY_Y + 12);
+    drawMarker(spinIndex == 1);
+    display.print(F("Intensity: "));
+    display.println(cfg.spinIntensity);
+
+    display.setCursor(0, BODY_Y + 24);
+    drawMarker(spinIndex == 2);
+    display.println(F("Back"));
+
+    // Visualizador de spin no canto direito
+    drawSpinVisualizer(92, BODY_Y, 32, cfg.spinMode);
+
+    // Mostra as potências dos motores na última linha (só se não for NONE)
+    if (cfg.spinMode != SPIN_NONE && cfg.spinIntensity > 0) {
+      int speed1, speed2, speed3;
+      getLauncherMotorSpeeds(cfg.launcherPower, cfg.spinMode, cfg.spinIntensity, speed1, speed2, speed3);
+
+      display.setCursor(0, 56);
+      display.print(F("M1:"));
+      display.print(speed1);
+      display.print(F(" M2:"));
+      display.print(speed2);
+      display.print(F(" M3:"));
+      display.print(speed3);
+    }
+  } while (nextPage());
 }
 
 #define FEEDER_VISIBLE 5
 #define FEEDER_LINE_H  8
 
 void renderFeeder() {
-  display.clearDisplay();
-  drawHeader("FEEDER");
-
-  int feederTotalItems = (cfg.feederMode == FEED_CUSTOM) ? 5 : 3;
-  int scrollOffset = (feederIndex >= feederTotalItems - FEEDER_VISIBLE)
-    ? (feederTotalItems - FEEDER_VISIBLE)
-    : (feederIndex >= 1 ? feederIndex - 1 : 0);
-  if (scrollOffset < 0) scrollOffset = 0;
-
-  for (int i = 0; i < FEEDER_VISIBLE && (scrollOffset + i) < feederTotalItems; i++) {
-    int idx = scrollOffset + i;
-    int y = BODY_Y + i * FEEDER_LINE_H;
-    display.setCursor(0, y);
-    display.print(idx == feederIndex ? "> " : "  ");
-
-    if (idx == 0) {
-      display.print("Mode: ");
-      display.println(feederModeLabel(cfg.feederMode));
-    } else if (idx == 1) {
-      display.print("Speed: ");
-      display.println(cfg.feederSpeed);
-    } else if (cfg.feederMode == FEED_CUSTOM && idx == 2) {
-      display.print("On(ms): ");
-      display.println((long)cfg.feederCustomOnMs);
-    } else if (cfg.feederMode == FEED_CUSTOM && idx == 3) {
-      display.print("Off(ms): ");
-      display.println((long)cfg.feederCustomOffMs);
-    } else {
-      display.println("Back");
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("FEEDER"));
+
+    int feederTotalItems = feederMaxIndex(cfg.feederMode) + 1;
+    int scrollOffset = (feederIndex >= feederTotalItems - FEEDER_VISIBLE)
+      ? (feederTotalItems - FEEDER_VISIBLE)
+      : (feederIndex >= 1 ? feederIndex - 1 : 0);
+    if (scrollOffset < 0) scrollOffset = 0;
+
+    for (int i = 0; i < FEEDER_VISIBLE && (scrollOffset + i) < feederTotalItems; i++) {
+      int idx = scrollOffset + i;
+      int y = BODY_Y + i * FEEDER_LINE_H;
+      display.setCursor(0, y);
+      drawMarker(idx == feederIndex);
+
+      if (idx == 0) {
+        display.print(F("Mode: "));
+        display.println(feederModeLabel(cfg.feederMode));
+      } else if (idx == 1) {
+        display.print(F("Speed: "));
+        display.println(cfg.feederSpeed);
+      } else if (cfg.feederMode == FEED_CUSTOM && idx == 2) {
+        display.print(F("On(ms): "));
+        display.println((long)cfg.feederCustomOnMs);
+      } else if (cfg.feederMode == FEED_CUSTOM && idx == 3) {
+        display.print(F("Off(ms): "));
+        display.println((long)cfg.feederCustomOffMs);
+      } else if (cfg.feederMode == FEED_BPM && idx == 2) {
+        display.print(F("Balls/min: "));
+        display.println(cfg.feederBpm);
+      } else {
+        display.println(F("Back"));
+      }
     }
-  }
 
-  // Mini gráfico do modo feeder na primeira linha, à direita (36x8 px com borda; barras 32x4 no interior)
-  drawFeederModeGraph(SCREEN_WIDTH - 36, BODY_Y, 36, 8, cfg.feederMode, cfg.feederCustomOnMs, cfg.feederCustomOffMs);
+    unsigned long onMs, offMs;
+    feederPulseTiming(cfg, onMs, offMs);
 
-  // Rotor (3 hélices) logo abaixo do gráfico de frequência; sincronizado com on/off, sentido horário, velocidade por feederSpeed
-  drawFeederRotor(SCREEN_WIDTH - 36, BODY_Y + 8 + 1, 36, cfg.feederMode, cfg.feederCustomOnMs, cfg.feederCustomOffMs, cfg.feederSpeed);
+    // Mini gráfico do modo feeder na primeira linha, à direita (36x8 px com borda; barras 32x4 no interior)
+    drawFeederModeGraph(SCREEN_WIDTH - 36, BODY_Y, 36, 8, cfg.feederMode, onMs, offMs);
 
-  display.display();
+    // Rotor (3 hélices) logo abaixo do gráfico de frequência; sincronizado com on/off, sentido horário, velocidade por feederSpeed
+    drawFeederRotor(SCREEN_WIDTH - 36, BODY_Y + 8 + 1, 36, cfg.feederMode, onMs, offMs, cfg.feederSpeed);
+  } while (nextPage());
 }
 
 void renderTimer() {
-  display.clearDisplay();
-  drawHeader("TIMER");
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("TIMER"));
 
-  display.setCursor(0, BODY_Y);
-  display.print(timerMenuIndex == 0 ? "> " : "  ");
-  display.print("Timer: ");
-  display.println(timerNameByIndex(cfg.timerIndex));
+    display.setCursor(0, BODY_Y);
+    drawMarker(timerMenuIndex == 0);
+    display.print(F("Timer: "));
+    display.println(timerNameByIndex(cfg.timerIndex));
 
-  display.setCursor(0, BODY_Y + 12);
-  display.print(timerMenuIndex == 1 ? "> " : "  ");
-  display.println("Back");
+    display.setCursor(0, BODY_Y + 12);
+    drawMarker(timerMenuIndex == 1);
+    display.print(F("Balls: "));
+    if (cfg.ballLimit == 0) display.println(F("OFF"));
+    else display.println(cfg.ballLimit);
 
-  display.display();
+    display.setCursor(0, BODY_Y + 24);
+    drawMarker(timerMenuIndex == 2);
+    display.println(F("Back"));
+  } while (nextPage());
 }
 
 void renderRunning() {
-  display.clearDisplay();
+  if (!beginFrame(currentScreen)) return;
 
-  bool blink = ((millis() / 350) % 2) == 0;
-  drawHeader(blink ? "RUNNING" : "       ");
+  bool blink = ((frameMillis() / 350) % 2) == 0;
+  char title[16];
+  title[0] = '\0';  // plain RUNNING
+  if (drillCurrentStep() != 0) {
+    snprintf_P(title, sizeof(title), PSTR("STEP %u/%u"), drillCurrentStep(), drillStepCount());
+  }
+  unsigned long tms = timerMsByIndex(cfg.timerIndex);
 
-  display.drawLine(0, 11, 127, 11, SSD1306_WHITE);
+  do {
+    if (!blink) drawHeader(F(""));
+    else if (title[0] != '\0') drawHeader(title);
+    else drawHeader(F("RUNNING"));
 
-  unsigned long tms = timerMsByIndex(cfg.timerIndex);
+    display.drawLine(0, 11, 127, 11, SSD1306_WHITE);
 
-  display.setCursor(0, BODY_Y);
-  if (tms == 0) {
-    unsigned long elapsed = millis() - runStartMs;
-    display.print("Elapsed: ");
-    display.print(elapsed / 1000);
-    display.println("s");
-  } else {
-    unsigned long elapsed = millis() - runStartMs;
-    long left = (long)tms - (long)elapsed;
-    if (left < 0) left = 0;
-
-    display.print("Left: ");
-    display.print(left / 1000);
-    display.println("s");
-  }
+    display.setCursor(0, BODY_Y);
+    if (tms == 0 && cfg.ballLimit > 0) {
+      display.print(F("Balls: "));
+      display.print(feederBallCount());
+      display.print('/');
+      display.println(cfg.ballLimit);
+    } else if (tms == 0) {
+      unsigned long elapsed = frameMillis() - runStartMs;
+      display.print(F("Elapsed: "));
+      display.print(elapsed / 1000);
+      display.println('s');
+    } else {
+      unsigned long elapsed = frameMillis() - runStartMs;
+      long left = (long)tms - (long)elapsed;
+      if (left < 0) left = 0;
 
-  display.setCursor(0, BODY_Y + 10);
-  display.print("Pan: ");
-  display.println(axisModeName(cfg.panMode));
+      display.print(F("Left: "));
+      display.print(left / 1000);
+      display.println('s');
+    }
 
-  display.setCursor(0, BODY_Y + 18);
-  display.print("Tilt: ");
-  display.println(axisModeName(cfg.tiltMode));
+    display.setCursor(0, BODY_Y + 10);
+    display.print(F("Pan: "));
+    display.println(axisModeName(cfg.panMode));
 
-  display.setCursor(0, BODY_Y + 28);
-  display.print("Power: ");
-  display.println(cfg.launcherPower);
+    display.setCursor(0, BODY_Y + 18);
+    display.print(F("Tilt: "));
+    display.println(axisModeName(cfg.tiltMode));
 
-  display.setCursor(0, BODY_Y + 38);
-  display.print("Spin: ");
-  display.println(spinModeName(cfg.spinMode));
+    display.setCursor(0, BODY_Y + 28);
+    display.print(F("Power: "));
+    display.println(cfg.launcherPower);
 
-  // Radar a bit higher
-  drawMiniRadarWithLimits(92, BODY_Y + 14, 32, livePan, liveTilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
+    display.setCursor(0, BODY_Y + 38);
+    display.print(F("Spin: "));
+    display.println(spinModeName(cfg.spinMode));
 
-  display.display();
+    // Radar a bit higher
+    drawMiniRadarWithLimits(92, BODY_Y + 14, 32, livePan, liveTilt, cfg.panMin, cfg.panMax, cfg.tiltMin, cfg.tiltMax);
+  } while (nextPage());
 }
 
-// Índices: 0=Servo1, 1=Servo2, 2=M1, 3=M2, 4=M3, 5=M4, 6=Back
-#define SETTINGS_ITEMS 7
-#define SETTINGS_VISIBLE 4
-
 void renderSettings() {
-  display.clearDisplay();
-  drawHeader("SETTINGS");
-
-  int scrollOffset = (settingsIndex >= SETTINGS_ITEMS - SETTINGS_VISIBLE)
-    ? (SETTINGS_ITEMS - SETTINGS_VISIBLE)
-    : (settingsIndex >= 1 ? settingsIndex - 1 : 0);
-  if (scrollOffset < 0) scrollOffset = 0;
-
-  const char* labels[SETTINGS_ITEMS] = { "Servo 1", "Servo 2", "M1", "M2", "M3", "M4", "Back" };
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(F("SETTINGS"));
 
-  for (int i = 0; i < SETTINGS_VISIBLE && (scrollOffset + i) < SETTINGS_ITEMS; i++) {
-    int idx = scrollOffset + i;
-    display.setCursor(0, BODY_Y + i * 12);
-    display.print(idx == settingsIndex ? "> " : "  ");
-    display.println(labels[idx]);
-  }
+    int scrollOffset = (settingsIndex >= SETTINGS_ITEMS - SETTINGS_VISIBLE)
+      ? (SETTINGS_ITEMS - SETTINGS_VISIBLE)
+      : (settingsIndex >= 1 ? settingsIndex - 1 : 0);
+    if (scrollOffset < 0) scrollOffset = 0;
 
-  display.display();
+    for (int i = 0; i < SETTINGS_VISIBLE && (scrollOffset + i) < SETTINGS_ITEMS; i++) {
+      int idx = scrollOffset + i;
+      display.setCursor(0, BODY_Y + i * 12);
+      drawMarker(idx == settingsIndex);
+      display.println(flashStr(SETTINGS_LABELS, (uint8_t)idx));
+    }
+  } while (nextPage());
 }
 
 void renderSettingsMotor() {
   char title[12];
-  sprintf(title, "M%d Test", settingsMotorTest);
-
-  display.clearDisplay();
-  drawHeader(title);
-
-  int focusMax = (settingsMotorTest == 4) ? 2 : 1;
-  int y = BODY_Y;
-
-  // Row 0: Speed
-  display.setCursor(0, y);
-  display.print(settingsMotorFocus == 0 ? "> " : "  ");
-  display.print("Speed: ");
-  display.println(settingsMotorSpeed);
-
-  int barX = 0;
-  int barY = BODY_Y + 14;
-  int barW = 128;
-  int barH = 8;
-  display.drawRect(barX, barY, barW, barH, SSD1306_WHITE);
-  int fillW = (settingsMotorSpeed * (barW - 2)) / 255;
-  if (fillW > 0) {
-    display.fillRect(barX + 1, barY + 1, fillW, barH - 2, SSD1306_WHITE);
-  }
+  sprintf_P(title, PSTR("M%d Test"), settingsMotorTest);
+
+  if (!beginFrame(currentScreen)) return;
+  do {
+    drawHeader(title);
 
-  y = BODY_Y + 28;
-  if (settingsMotorTest == 4) {
+    int focusMax = (settingsMotorTest == 4) ? 2 : 1;
+    int y = BODY_Y;
+
+    // Row 0: Speed
     display.setCursor(0, y);
-    display.print(settingsMotorFocus == 1 ? "> " : "  ");
-    display.print("Revert: ");
-    display.println(settingsMotorM4Revert ? "Yes" : "No");
-    y += 12;
-  }
+    drawMarker(settingsMotorFocus == 0);
+    display.print(F("Speed: "));
+    display.println(settingsMotorSpeed);
+
+    int barX = 0;
+    int barY = BODY_Y + 14;
+    int barW = 128;
+    int barH = 8;
+    display.drawRect(barX, barY, barW, barH, SSD1306_WHITE);
+    int fillW = (settingsMotorSpeed * (barW - 2)) / 255;
+    if (fillW > 0) {
+      display.fillRect(barX + 1, barY + 1, fillW, barH - 2, SSD1306_WHITE);
+    }
 
-  display.setCursor(0, y);
-  display.print(settingsMotorFocus == focusMax ? "> " : "  ");
-  display.println("Back");
+    y = BODY_Y + 28;
+    if (settingsMotorTest == 4) {
+      display.setCursor(0, y);
+      drawMarker(settingsMotorFocus == 1);
+      display.print(F("Revert: "));
+      display.println(settingsMotorM4Revert ? F("Yes") : F("No"));
+      y += 12;
+    }
 
-  display.display();
+    display.setCursor(0, y);
+    drawMarker(settingsMotorFocus == focusMax);
+    display.println(F("Back"));
+  } while (nextPage());
 }
 
 void renderSettingsServo() {
-  display.clearDisplay();
-  
-  // Título baseado no servo selecionado
-  if (settingsServoSelected == 0) {
-    drawHeader("SERVO 1");
-  } else {
-    drawHeader("SERVO 2");
-  }
-
-  // Mostra os limites do servo selecionado
-  if (settingsServoSelected == 0) {
-    // Servo 1 (TILT)
-    display.setCursor(0, BODY_Y);
-    display.print(settingsServoEditIndex == 0 ? "> " : "  ");
-    display.print("MIN: ");
-    if (settingsServoEditIndex == 0) display.print("[");
-    display.print(servo_tilt_up);
-    if (settingsServoEditIndex == 0) display.print("]");
-    else display.println();
-
-    display.setCursor(0, BODY_Y + 12);
-    display.print(settingsServoEditIndex == 1 ? "> " : "  ");
-    display.print("MID: ");
-    if (settingsServoEditIndex == 1) display.print("[");
-    display.print(servo_tilt_mid);
-    if (settingsServoEditIndex == 1) display.print("]");
-    else display.println();
-
-    display.setCursor(0, BODY_Y + 24);
-    display.print(settingsServoEditIndex == 2 ? "> " : "  ");
-    display.print("MAX: ");
-    if (settingsServoEditIndex == 2) display.print("[");
-    display.print(servo_tilt_down);
-    if (settingsServoEditIndex == 2) display.print("]");
-    else display.println();
-  } else {
-    // Servo 2 (PAN)
-    display.setCursor(0, BODY_Y);
-    display.print(settingsServoEditIndex == 0 ? "> " : "  ");
-    display.print("MIN: ");
-    if (settingsServoEditIndex == 0) display.print("[");
-    display.print(servo_pan_left);
-    if (settingsServoEditIndex == 0) display.print("]");
-    else display.println();
-
-    display.setCursor(0, BODY_Y + 12);
-    display.print(settingsServoEditIndex == 1 ? "> " : "  ");
-    display.print("MID: ");
-    if (settingsServoEditIndex == 1) display.print("[");
-    display.print(servo_pan_mid);
-    if (settingsServoEditIndex == 1) display.print("]");
-    else display.println();
-
-    display.setCursor(0, BODY_Y + 24);
-    display.print(settingsServoEditIndex == 2 ? "> " : "  ");
-    display.print("MAX: ");
-    if (settingsServoEditIndex == 2) display.print("[");
-    display.print(servo_pan_right);
-    if (settingsServoEditIndex == 2) display.print("]");
-    else display.println();
-  }
+  if (!beginFrame(currentScreen)) return;
+  do {
+    // Título baseado no servo selecionado
+    if (settingsServoSelected == 0) {
+      drawHeader(F("SERVO 1"));
+    } else {
+      drawHeader(F("SERVO 2"));
+    }
 
-  // Back
-  display.setCursor(0, BODY_Y + 36);
-  display.print(settingsServoEditIndex == 3 ? "> " : "  ");
-  display.println("Back");
+    // Mostra os limites do servo selecionado
+    if (settingsServoSelected == 0) {
+      // Servo 1 (TILT)
+      display.setCursor(0, BODY_Y);
+      drawMarker(settingsServoEditIndex == 0);
+      display.print(F("MIN: "));
+      if (settingsServoEditIndex == 0) display.print('[');
+      display.print(servo_tilt_up);
+      if (settingsServoEditIndex == 0) display.print(']');
+      else display.println();
+
+      display.setCursor(0, BODY_Y + 12);
+      drawMarker(settingsServoEditIndex == 1);
+      display.print(F("MID: "));
+      if (settingsServoEditIndex == 1) display.print('[');
+      display.print(servo_tilt_mid);
+      if (settingsServoEditIndex == 1) display.print(']');
+      else display.println();
+
+      display.setCursor(0, BODY_Y + 24);
+      drawMarker(settingsServoEditIndex == 2);
+      display.print(F("MAX: "));
+      if (settingsServoEditIndex == 2) display.print('[');
+      display.print(servo_tilt_down);
+      if (settingsServoEditIndex == 2) display.print(']');
+      else display.println();
+    } else {
+      // Servo 2 (PAN)
+      display.setCursor(0, BODY_Y);
+      drawMarker(settingsServoEditIndex == 0);
+      display.print(F("MIN: "));
+      if (settingsServoEditIndex == 0) display.print('[');
+      display.print(servo_pan_left);
+      if (settingsServoEditIndex == 0) display.print(']');
+      else display.println();
+
+      display.setCursor(0, BODY_Y + 12);
+      drawMarker(settingsServoEditIndex == 1);
+      display.print(F("MID: "));
+      if (settingsServoEditIndex == 1) display.print('[');
+      display.print(servo_pan_mid);
+      if (settingsServoEditIndex == 1) display.print(']');
+      else display.println();
+
+      display.setCursor(0, BODY_Y + 24);
+      drawMarker(settingsServoEditIndex == 2);
+      display.print(F("MAX: "));
+      if (settingsServoEditIndex == 2) display.print('[');
+      display.print(servo_pan_right);
+      if (settingsServoEditIndex == 2) display.print(']');
+      else display.println();
+    }
 
-  display.display();
+    // Back
+    display.setCursor(0, BODY_Y + 36);
+    drawMarker(settingsServoEditIndex == 3);
+    display.println(F("Back"));
+  } while (nextPage());
 }
@@ -5,9 +5,10 @@
 
 void renderHome();
 void renderInfo();
+void renderProfiles();
 void renderWizard();
-void renderAxisMenu(const char* title, AxisMode mode, float targetValue, int menuIndex);
-void renderAxisEdit(const char* title, float value);
+void renderAxisMenu(bool isPan, AxisMode mode, q16_t targetValue, int menuIndex);
+void renderAxisEdit(bool isPan, q16_t value);
 void renderLauncher();
 void renderSpin();
 void renderFeeder();
@@ -1,11 +1,21 @@
 #include "servos.h"
 #include "utils.h"
+#include "motion.h"
 #include <Arduino.h>
 #include <EEPROM.h>
 
 #define EEPROM_SERVO_BASE  0
 #define EEPROM_SERVO_MAGIC 6
 #define EEPROM_SERVO_MAGIC_VAL 0xA5
+// Calibration: SERVO_CAL_POINTS int8 per servo, tilt then pan (bytes 8-9 are the HM-10 rate)
+#define EEPROM_SERVO_CAL_BASE  10
+#define EEPROM_SERVO_CAL_MAGIC (EEPROM_SERVO_CAL_BASE + 2 * SERVO_CAL_POINTS)
+#define EEPROM_SERVO_CAL_MAGIC_VAL 0xA5
+
+#define CAL_SEG_SHIFT (MOTION_FRAC_BITS + 4)  // 16 deg per segment
+#if (1 << 4) != SERVO_CAL_STEP_DEG
+#error "CAL_SEG_SHIFT assumes 16 deg calibration steps"
+#endif
 
 Servo tiltServo; // SERVO1 (subir/descer)
 Servo panServo;  // SERVO2 (esquerda/direita)
@@ -20,21 +30,46 @@ int servo_pan_left = 15;
 int servo_pan_mid = 70;
 int servo_pan_right = 125;
 
-// Mapeamento genérico assimétrico: (-1..+1) com MID real no centro lógico
-int normalizedToAngle(float x, int minAngle, int midAngle, int maxAngle) {
-  x = clampFloat(x, -1.0f, 1.0f);
+int8_t servoCal[2][SERVO_CAL_POINTS];  // zero: the Servo library's linear map
 
-  if (x < 0.0f) {
-    // MID -> MIN
-    float a = (float)midAngle + x * (midAngle - minAngle);
-    return clampInt((int)(a + 0.5f), minAngle, midAngle);
-  } else {
-    // MID -> MAX
-    float a = (float)midAngle + x * (maxAngle - midAngle);
-    return clampInt((int)(a + 0.5f), midAngle, maxAngle);
+// Pulse at each calibration point; rebuilt by applyServoCal() so writeServoPos() is a lookup and
+// one multiply
+static uint16_t servoCalUs[2][SERVO_CAL_POINTS];
+static int servoWrittenUs[2] = { -1, -1 };
+
+// Mapeamento genérico assimétrico: (-1..+1, Q16) com MID real no centro lógico
+// |x| <= Q16_ONE and spans <= 180 deg, so x * span fits in int32; Q16 deg >> 4 = 1/4096 deg.
+int32_t normalizedToPos(q16_t x, int minAngle, int midAngle, int maxAngle) {
+  x = q16Clamp(x, -Q16_ONE, Q16_ONE);
+  const int span = (x < 0) ? (midAngle - minAngle) : (maxAngle - midAngle);  // MID -> MIN / MID -> MAX
+  return MOTION_DEG(midAngle) + ((x * (int32_t)span) >> (16 - MOTION_FRAC_BITS));
+}
+
+void applyServoCal() {
+  for (uint8_t s = 0; s < 2; s++) {
+    for (uint8_t i = 0; i < SERVO_CAL_POINTS; i++) {
+      const long deg = (long)i * SERVO_CAL_STEP_DEG;
+      const long us = MIN_PULSE_WIDTH + deg * (MAX_PULSE_WIDTH - MIN_PULSE_WIDTH) / 180 + servoCal[s][i];
+      servoCalUs[s][i] = (uint16_t)us;
+    }
+    servoWrittenUs[s] = -1;
   }
 }
 
+void writeServoPos(uint8_t servo, int32_t pos) {
+  if (pos < 0) pos = 0;
+  if (pos > MOTION_DEG(180)) pos = MOTION_DEG(180);
+  const uint8_t seg = (uint8_t)(pos >> CAL_SEG_SHIFT);
+  const int32_t frac = pos & ((1L << CAL_SEG_SHIFT) - 1);
+  const uint16_t* p = servoCalUs[servo];
+  // Widen before subtracting: uint16_t - uint16_t stays unsigned on AVR (16-bit int), so a
+  // falling segment would come out as ~65000
+  const int us = (int)p[seg] + (int)((((int32_t)p[seg + 1] - (int32_t)p[seg]) * frac) >> CAL_SEG_SHIFT);
+  if (us == servoWrittenUs[servo]) return;
+  servoWrittenUs[servo] = us;
+  (servo == SERVO_TILT ? tiltServo : panServo).writeMicroseconds(us);
+}
+
 void loadServoLimitsFromEEPROM() {
   if (EEPROM.read(EEPROM_SERVO_MAGIC) != EEPROM_SERVO_MAGIC_VAL) return;
   servo_tilt_up    = EEPROM.read(EEPROM_SERVO_BASE + 0);
@@ -61,22 +96,43 @@ void saveServoLimitsToEEPROM() {
   EEPROM.write(EEPROM_SERVO_MAGIC, EEPROM_SERVO_MAGIC_VAL);
 }
 
+static void loadServoCalFromEEPROM() {
+  if (EEPROM.read(EEPROM_SERVO_CAL_MAGIC) != EEPROM_SERVO_CAL_MAGIC_VAL) return;
+  for (uint8_t s = 0; s < 2; s++) {
+    for (uint8_t i = 0; i < SERVO_CAL_POINTS; i++) {
+      int8_t c = (int8_t)EEPROM.read(EEPROM_SERVO_CAL_BASE + s * SERVO_CAL_POINTS + i);
+      if (c < -SERVO_CAL_MAX_US) c = -SERVO_CAL_MAX_US;
+      servoCal[s][i] = c;
+    }
+  }
+}
+
+void saveServoCalToEEPROM() {
+  for (uint8_t s = 0; s < 2; s++) {
+    for (uint8_t i = 0; i < SERVO_CAL_POINTS; i++) {
+      EEPROM.update(EEPROM_SERVO_CAL_BASE + s * SERVO_CAL_POINTS + i, (uint8_t)servoCal[s][i]);
+    }
+  }
+  EEPROM.update(EEPROM_SERVO_CAL_MAGIC, EEPROM_SERVO_CAL_MAGIC_VAL);
+}
+
 void initServos() {
   loadServoLimitsFromEEPROM();
+  loadServoCalFromEEPROM();
+  applyServoCal();
 
   tiltServo.attach(SERVO_TILT_PIN); // SERVO1
   panServo.attach(SERVO_PAN_PIN);   // SERVO2
 
-  tiltServo.write(servo_tilt_mid);
-  panServo.write(servo_pan_mid);
+  writeServoPos(SERVO_TILT, MOTION_DEG(servo_tilt_mid));
+  writeServoPos(SERVO_PAN, MOTION_DEG(servo_pan_mid));
+  motionInit(servo_pan_mid, servo_tilt_mid);
 }
 
-void updateServos(float panNormalized, float tiltNormalized) {
-  int tiltAngle = normalizedToAngle(tiltNormalized, servo_tilt_up, servo_tilt_mid, servo_tilt_down);
-  int panAngle  = normalizedToAngle(panNormalized, servo_pan_left, servo_pan_mid, servo_pan_right);
-
-  tiltServo.write(tiltAngle);
-  panServo.write(panAngle);
+// Sets the target; the servos get there on the control tick (motionTick)
+void updateServos(q16_t panNormalized, q16_t tiltNormalized) {
+  motionSetTarget(normalizedToPos(panNormalized, servo_pan_left, servo_pan_mid, servo_pan_right),
+                  normalizedToPos(tiltNormalized, servo_tilt_up, servo_tilt_mid, servo_tilt_down));
 }
 
 void updateServosForSettingsPreview(int selectedServo, int editIndex) {
@@ -86,16 +142,13 @@ void updateServosForSettingsPreview(int selectedServo, int editIndex) {
   }
   if (selectedServo == 0) {
     int tiltAngle = (editIndex == 0) ? servo_tilt_up : (editIndex == 1) ? servo_tilt_mid : servo_tilt_down;
-    tiltServo.write(tiltAngle);
-    panServo.write(servo_pan_mid);
+    motionSetTarget(MOTION_DEG(servo_pan_mid), MOTION_DEG(tiltAngle));
   } else {
     int panAngle = (editIndex == 0) ? servo_pan_left : (editIndex == 1) ? servo_pan_mid : servo_pan_right;
-    panServo.write(panAngle);
-    tiltServo.write(servo_tilt_mid);
+    motionSetTarget(MOTION_DEG(panAngle), MOTION_DEG(servo_tilt_mid));
   }
 }
 
 void servosGoToMid() {
-  tiltServo.write(servo_tilt_mid);
-  panServo.write(servo_pan_mid);
+  motionSetTarget(MOTION_DEG(servo_pan_mid), MOTION_DEG(servo_tilt_mid));
 }
@@ -2,11 +2,24 @@
 #define SERVOS_H
 
 #include <Servo.h>
+#include "fixedpoint.h"
 
 // Pinos do shield L293D
 #define SERVO_TILT_PIN 10  // SERVO1
 #define SERVO_PAN_PIN  9   // SERVO2
 
+#define SERVO_TILT 0  // index for the calibration tables and writeServoPos (same as settingsServoSelected)
+#define SERVO_PAN  1
+
+// Pulse-width calibration: a correction in µs from the Servo library's linear 0..180 deg ->
+// MIN_PULSE_WIDTH..MAX_PULSE_WIDTH map, every SERVO_CAL_STEP_DEG of commanded angle (0, 16, ...,
+// 192; the last point only bounds the 176..180 segment). Linear in between.
+#define SERVO_CAL_POINTS   13
+#define SERVO_CAL_STEP_DEG 16
+#define SERVO_CAL_MAX_US   127
+
+extern int8_t servoCal[2][SERVO_CAL_POINTS];
+
 // Limites dos servos (editáveis)
 extern int servo_tilt_up;
 extern int servo_tilt_mid;
@@ -17,12 +30,15 @@ extern int servo_pan_mid;
 extern int servo_pan_right;
 
 void initServos();
-void updateServos(float panNormalized, float tiltNormalized);
+void updateServos(q16_t panNormalized, q16_t tiltNormalized);  // target for the motion planner (motion.h)
 void updateServosForSettingsPreview(int selectedServo, int editIndex);
 void servosGoToMid();
-int normalizedToAngle(float x, int minAngle, int midAngle, int maxAngle);
+int32_t normalizedToPos(q16_t x, int minAngle, int midAngle, int maxAngle);  // 1/4096 deg (MOTION_DEG)
+void writeServoPos(uint8_t servo, int32_t pos);  // angle in 1/4096 deg -> calibrated pulse
 void loadServoLimitsFromEEPROM();
 void saveServoLimitsToEEPROM();
+void applyServoCal();        // after editing servoCal: rebuilds the pulse tables
+void saveServoCalToEEPROM();
 
 extern Servo tiltServo;
 extern Servo panServo;
@@ -0,0 +1,65 @@
+#include "shot.h"
+#include "logic.h"
+#include "motors.h"
+#include "servos.h"
+#include "motion.h"
+
+// What the servos and launcher were last given
+static q16_t shotPan = 0;
+static q16_t shotTilt = 0;
+static int shotPower = -1;
+static SpinMode shotSpin = SPIN_NONE;
+static int shotIntensity = 0;
+static unsigned long shotReadyMs = 0;  // feeding allowed from here on
+
+static bool axisHeld(AxisMode mode) {
+  return mode == AXIS_AUTO2 || mode == AXIS_RANDOM;
+}
+
+static void extendReady(unsigned long now, unsigned long waitMs) {
+  if ((long)(now + waitMs - shotReadyMs) > 0) shotReadyMs = now + waitMs;
+}
+
+void shotStart() {
+  shotPan = livePan;
+  shotTilt = liveTilt;
+  shotPower = -1;  // the first tick applies cfg
+  shotReadyMs = millis();
+}
+
+bool shotHolding() {
+  return feederPhase == FEEDER_UNJAM || (cfg.feederMode != FEED_CONTINUOUS && feederPhase == FEEDER_ON);
+}
+
+void shotTick(q16_t pan, q16_t tilt) {
+  const unsigned long now = millis();
+  const bool hold = shotHolding();
+
+  // Aim: held axes only move between balls, and the feed waits until the head has arrived
+  bool stepped = false;
+  if (!hold || !axisHeld(cfg.panMode)) {
+    if (axisHeld(cfg.panMode) && pan != shotPan) stepped = true;
+    shotPan = pan;
+  }
+  if (!hold || !axisHeld(cfg.tiltMode)) {
+    if (axisHeld(cfg.tiltMode) && tilt != shotTilt) stepped = true;
+    shotTilt = tilt;
+  }
+  updateServos(shotPan, shotTilt);
+  if (stepped) extendReady(now, motionArrivalMs() + SHOT_SERVO_SETTLE_MS);
+
+  // Spin: a new power or spin takes effect between balls, then the wheels get time to settle
+  if (!hold && (cfg.launcherPower != shotPower || cfg.spinMode != shotSpin || cfg.spinIntensity != shotIntensity)) {
+    shotPower = cfg.launcherPower;
+    shotSpin = cfg.spinMode;
+    shotIntensity = cfg.spinIntensity;
+    extendReady(now, SHOT_SPIN_SETTLE_MS);
+  }
+  updateLauncherMotors(shotPower, shotSpin, shotIntensity);
+  if (!launcherAtTarget()) extendReady(now, SHOT_SPIN_SETTLE_MS);
+
+  // Atualizar motor feeder (M4); runStartMs usado para recuada inicial de 0,5 s
+  unsigned long onMs, offMs;
+  feederPulseTiming(cfg, onMs, offMs);
+  updateFeederMotor(cfg.feederSpeed, cfg.feederMode, onMs, offMs, runStartMs, (long)(now - shotReadyMs) >= 0);
+}
@@ -0,0 +1,23 @@
+#ifndef SHOT_H
+#define SHOT_H
+
+#include <Arduino.h>
+#include "fixedpoint.h"
+
+// Shot scheduler: ties aim steps, spin changes and the feeder together so a ball is never fed
+// while the head is still moving. With a pulsed feeder mode, aim (AUTO2 and RANDOM axes) and
+// launcher changes are held while the feeder is ON and applied between balls; the next ON phase
+// then waits for the motion planner's predicted arrival (motion.h) plus a short settle, and for
+// the launcher ramp plus the wheels to reach the new speed. LIVE and AUTO1 axes move continuously and are passed straight through. With
+// continuous feeding there is no gap between balls, so everything is applied immediately.
+
+#define SHOT_SERVO_SETTLE_MS  30   // servo horn catching up with the end of the planned move
+#define SHOT_SPIN_SETTLE_MS   400  // wheels catching up once the launcher PWM ramp has finished
+
+void shotStart();  // from startRunning()
+// Every running control tick, in place of the servo and motor updates. pan/tilt is where the
+// aim logic wants the head.
+void shotTick(q16_t pan, q16_t tilt);
+bool shotHolding();  // a ball is being fed (or un-jammed): AUTO2/RANDOM axes should not step
+
+#endif
@@ -0,0 +1,76 @@
+#include "tach.h"
+#include "config.h"
+
+uint16_t launcherRpm[3] = { 0, 0, 0 };
+
+#if LAUNCHER_TACH
+
+// Port K is PCINT16..23 = A8..A15, all on PCINT2_vect (A8/A9 are the joystick, not masked).
+#define TACH_BIT(pin) ((uint8_t)(1 << ((pin) - A8)))
+#define TACH_MASK     (TACH_BIT(TACH_PIN_1) | TACH_BIT(TACH_PIN_2) | TACH_BIT(TACH_PIN_3))
+
+static const uint8_t TACH_BITS[3] = { TACH_BIT(TACH_PIN_1), TACH_BIT(TACH_PIN_2), TACH_BIT(TACH_PIN_3) };
+
+// Shared with the ISR; read and cleared with interrupts off
+static volatile unsigned long tachLastEdgeUs[3];
+static volatile unsigned long tachSumUs[3];  // edge periods since the last tachUpdate()
+static volatile uint8_t tachEdges[3];
+static volatile bool tachSeen[3];            // tachLastEdgeUs is a real edge of a turning wheel
+static uint8_t tachLastPins = 0xFF;          // ISR only
+
+ISR(PCINT2_vect) {
+  const uint8_t pins = PINK;
+  const uint8_t fell = tachLastPins & ~pins & TACH_MASK;
+  tachLastPins = pins;
+  if (!fell) return;
+  const unsigned long now = micros();
+  for (uint8_t i = 0; i < 3; i++) {
+    if (!(fell & TACH_BITS[i])) continue;
+    const unsigned long period = now - tachLastEdgeUs[i];
+    if (tachSeen[i]) {
+      if (period < TACH_MIN_PERIOD_US) continue;
+      tachSumUs[i] += period;
+      if (tachEdges[i] < 255) tachEdges[i]++;
+    }
+    tachLastEdgeUs[i] = now;
+    tachSeen[i] = true;
+  }
+}
+
+void initTach() {
+  pinMode(TACH_PIN_1, INPUT_PULLUP);
+  pinMode(TACH_PIN_2, INPUT_PULLUP);
+  pinMode(TACH_PIN_3, INPUT_PULLUP);
+  tachLastPins = PINK;
+  PCMSK2 |= TACH_MASK;
+  PCICR |= (uint8_t)(1 << PCIE2);
+}
+
+void tachUpdate() {
+  for (uint8_t i = 0; i < 3; i++) {
+    noInterrupts();
+    const unsigned long now = micros();
+    const unsigned long sumUs = tachSumUs[i];
+    const uint8_t edges = tachEdges[i];
+    tachSumUs[i] = 0;
+    tachEdges[i] = 0;
+    // A stopped wheel: the next edge only re-anchors instead of giving one huge period
+    const bool stopped = !tachSeen[i] || (now - tachLastEdgeUs[i]) >= TACH_TIMEOUT_MS * 1000UL;
+    if (stopped) tachSeen[i] = false;
+    interrupts();
+
+    if (edges > 0) {
+      const unsigned long rpm = 60000000UL / TACH_PULSES_PER_REV / (sumUs / edges);
+      launcherRpm[i] = rpm > 65535UL ? 65535 : (uint16_t)rpm;
+    } else if (stopped) {
+      launcherRpm[i] = 0;
+    }
+  }
+}
+
+#else
+
+void initTach() {}
+void tachUpdate() {}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef TACH_H
+#define TACH_H
+
+#include <Arduino.h>
+
+// Launcher wheel tachometers (TACH_PIN_1..3, falling edge per pulse). The pin-change ISR keeps the
+// sum of edge periods per wheel; tachUpdate() averages them once per control tick, so a tick
+// with several edges and one with none both give a steady reading. Compiled out unless
+// LAUNCHER_TACH is set, in which case launcherRpm stays 0.
+
+void initTach();
+void tachUpdate();  // every running control tick, before the launcher loop uses launcherRpm
+
+extern uint16_t launcherRpm[3];  // measured wheel speed M1..M3; 0 when stopped or not fitted
+
+#endif
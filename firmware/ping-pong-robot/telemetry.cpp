@@ -0,0 +1,66 @@
+#include "telemetry.h"
+#include "bt_frame.h"
+#include "bt_command.h"
+#include "aim_stream.h"
+#include "config.h"
+#include "control.h"
+#include "jam.h"
+#include "logic.h"
+#include "motors.h"
+#include "profiler.h"
+#include "tach.h"
+
+unsigned long telemetrySkipped = 0;
+
+static bool telemetryOn = false;
+static unsigned long telemetryLastMs = 0;
+static uint8_t telemetrySeq = 0;
+
+static uint8_t* putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static uint16_t sat16(unsigned long v) {
+  return v > 0xFFFFUL ? 0xFFFF : (uint16_t)v;
+}
+
+void setTelemetryEnabled(bool on) {
+  telemetryOn = on;
+}
+
+void updateTelemetry() {
+  if (!telemetryOn) return;
+  const unsigned long now = millis();
+  if (now - telemetryLastMs < TELEMETRY_PERIOD_MS) return;
+  telemetryLastMs = now;
+
+  configRevisionPoll();
+  ProfStats loopStats;
+  profGetStats(PROF_LOOP, loopStats);
+
+  uint8_t buf[TELEMETRY_PAYLOAD_LEN];
+  uint8_t* p = buf;
+  *p++ = telemetrySeq;
+  *p++ = (uint8_t)((isRunning ? 0x01 : 0) | (aimStreamActive() ? 0x02 : 0));
+  p = putU16(p, (uint16_t)q16ToMilli(isRunning ? livePan : cfg.panTarget));
+  p = putU16(p, (uint16_t)q16ToMilli(isRunning ? liveTilt : cfg.tiltTarget));
+  p = putU16(p, (uint16_t)(isRunning ? lastLauncherSpeed1 : 0));
+  p = putU16(p, (uint16_t)(isRunning ? lastLauncherSpeed2 : 0));
+  p = putU16(p, (uint16_t)(isRunning ? lastLauncherSpeed3 : 0));
+  *p++ = (uint8_t)feederPhase;
+  p = putU16(p, sat16(loopStats.p50Us));
+  p = putU16(p, sat16(loopStats.maxUs));
+  p = putU16(p, sat16(controlOverruns));
+  const unsigned long elapsed = isRunning ? now - runStartMs : 0;
+  p = putU16(p, (uint16_t)(elapsed & 0xFFFF));
+  p = putU16(p, (uint16_t)(elapsed >> 16));
+  p = putU16(p, (uint16_t)feederBallCount());
+  p = putU16(p, jamCount);
+  for (uint8_t i = 0; i < 3; i++) p = putU16(p, isRunning ? launcherRpm[i] : 0);
+  p = putU16(p, configRevision);
+
+  if (!btFrameSend(BT_FRAME_TELEMETRY, buf, TELEMETRY_PAYLOAD_LEN)) telemetrySkipped++;
+  telemetrySeq++;
+}
@@ -0,0 +1,30 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// Periodic robot -> app state as one BT_FRAME_TELEMETRY frame, sent only to an app that has
+// negotiated frames ("V"). Frames are queued on TX_STREAM (tx_queue.h); when that ring is full the
+// sample is skipped and counted. Payload, little-endian:
+//   u8  seq                            +1 per period, so skipped samples show as gaps
+//   u8  flags        bit0 running, bit1 aim stream active
+//   s16 pan*1000, s16 tilt*1000        live aim while running, targets otherwise
+//   s16 m1, m2, m3                     launcher speeds (-255..255, negative = reverse)
+//   u8  feederPhase                    FeederPhase (motors.h)
+//   u16 loop p50 us, u16 loop max us   profiler PROF_LOOP, saturated
+//   u16 controlOverruns                saturated
+//   u32 run elapsed ms                 0 when stopped
+//   u16 shots                          balls this run (feederBallCount: exit sensor, else pulses)
+//   u16 jams                           feeder jams detected this run (jam.h)
+//   u16 rpm1, rpm2, rpm3               measured wheel speeds (tach.h), 0 without tachs
+//   u16 configRevision                 bt_command.h; includes changes made on the robot
+
+#define TELEMETRY_PERIOD_MS   200UL  // 5 Hz x 41 bytes = 205 B/s: ~21% of 9600 baud (960 B/s), ~4% of 57600
+#define TELEMETRY_PAYLOAD_LEN 35
+
+extern unsigned long telemetrySkipped;  // samples dropped because the stream queue was full
+
+void setTelemetryEnabled(bool on);
+void updateTelemetry();  // called every loop(); sends at most one frame per TELEMETRY_PERIOD_MS
+
+#endif
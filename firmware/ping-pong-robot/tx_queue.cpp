@@ -0,0 +1,123 @@
+#include "tx_queue.h"
+#include "bt_command.h"
+
+unsigned long txDropped[TX_CHANNEL_COUNT] = { 0, 0, 0 };
+unsigned long txWaits = 0;
+
+// Messages are stored as <len><bytes>. `left` counts the bytes of the message at `head` that are
+// still to go out; 0 means the next byte is a length.
+struct TxRing {
+  uint8_t* buf;
+  uint8_t size;
+  uint8_t head;
+  uint8_t used;
+  uint8_t left;
+};
+
+static uint8_t txReplyBuf[TX_REPLY_BUF];
+static uint8_t txStreamBuf[TX_STREAM_BUF];
+static uint8_t txLogBuf[TX_LOG_BUF];
+
+static TxRing txRings[TX_CHANNEL_COUNT] = {
+  { txReplyBuf, TX_REPLY_BUF, 0, 0, 0 },
+  { txStreamBuf, TX_STREAM_BUF, 0, 0, 0 },
+  { txLogBuf, TX_LOG_BUF, 0, 0, 0 },
+};
+
+static bool onBtPort(TxChannel ch) {
+  return ch != TX_LOG;
+}
+
+static HardwareSerial& portUart(bool bt) {
+  return bt ? BT_SERIAL : Serial;
+}
+
+// Ring whose message goes out next on a port: one already started, else the highest priority.
+static TxRing* nextRing(bool bt) {
+  if (!bt) return txRings[TX_LOG].used ? &txRings[TX_LOG] : nullptr;
+  if (txRings[TX_STREAM].left) return &txRings[TX_STREAM];
+  if (txRings[TX_REPLY].used) return &txRings[TX_REPLY];
+  if (txRings[TX_STREAM].used) return &txRings[TX_STREAM];
+  return nullptr;
+}
+
+static uint8_t popByte(TxRing& r) {
+  uint8_t b = r.buf[r.head];
+  if (++r.head == r.size) r.head = 0;
+  r.used--;
+  return b;
+}
+
+// Writes up to `room` queued bytes to the port's UART. The caller decides how much room there is;
+// anything past availableForWrite() waits inside HardwareSerial::write.
+static void drainPort(bool bt, int room) {
+  HardwareSerial& uart = portUart(bt);
+  while (room > 0) {
+    TxRing* r = nextRing(bt);
+    if (!r) return;
+    if (r->left == 0) r->left = popByte(*r);
+    while (r->left > 0 && room > 0) {
+      uart.write(popByte(*r));
+      r->left--;
+      room--;
+    }
+  }
+}
+
+static uint8_t ringFree(const TxRing& r) {
+  return (uint8_t)(r.size - r.used);
+}
+
+uint8_t txRoom(TxChannel ch) {
+  uint8_t free = ringFree(txRings[ch]);
+  return free > 0 ? (uint8_t)(free - 1) : 0;
+}
+
+bool txQueue(TxChannel ch, const uint8_t* data, uint8_t len, bool mustSend) {
+  if (len == 0) return true;
+  TxRing& r = txRings[ch];
+  const bool bt = onBtPort(ch);
+  if ((uint16_t)len + 1 > r.size) {
+    txDropped[ch]++;
+    return false;
+  }
+  if (ringFree(r) < (uint16_t)len + 1) {
+    if (ch != TX_REPLY && !mustSend) {
+      txDropped[ch]++;
+      return false;
+    }
+    txWaits++;
+    while (ringFree(r) < (uint16_t)len + 1) drainPort(bt, 1);
+  }
+
+  uint16_t tail = (uint16_t)r.head + r.used;  // rings up to 255 bytes: the sum needs 9 bits
+  if (tail >= r.size) tail -= r.size;
+  uint8_t pos = (uint8_t)tail;
+  r.buf[pos] = len;
+  for (uint8_t i = 0; i < len; i++) {
+    if (++pos == r.size) pos = 0;
+    r.buf[pos] = data[i];
+  }
+  r.used += len + 1;
+
+  drainPort(bt, portUart(bt).availableForWrite());
+  return true;
+}
+
+void txDrain() {
+  drainPort(true, BT_SERIAL.availableForWrite());
+  drainPort(false, Serial.availableForWrite());
+}
+
+size_t TxLine::write(uint8_t c) {
+  if (len_ == TX_MSG_MAX) send();
+  buf_[len_++] = c;
+  if (c == '\n') send();
+  return 1;
+}
+
+void TxLine::send() {
+  if (len_ == 0) return;
+  txQueue(ch_, buf_, len_, mustSend_);
+  len_ = 0;
+}
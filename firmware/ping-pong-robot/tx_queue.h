@@ -0,0 +1,54 @@
+#ifndef TX_QUEUE_H
+#define TX_QUEUE_H
+
+#include <Arduino.h>
+
+// Outbound queue for Serial1 (app) and Serial (debug). A message is copied whole into a RAM ring
+// and txDrain() hands bytes to HardwareSerial only while its TX buffer has room, so loop() never
+// waits on a 9600 baud link. Messages never interleave on the wire. Channels:
+//   TX_REPLY   Serial1: OK/ERR replies, AT commands, timing dumps. Never dropped; sent before any
+//              queued TX_STREAM message.
+//   TX_STREAM  Serial1: telemetry frames, live aim echoes. Dropped whole when the ring is full.
+//   TX_LOG     Serial: debug text. Dropped whole when the ring is full.
+// A message that must not be dropped (every TX_REPLY message, or mustSend) and does not fit waits
+// for the UART to take the oldest queued bytes; that is the only path that can block.
+
+// Ring sizes are uint8_t, so 255 at most
+#define TX_REPLY_BUF   255
+#define TX_STREAM_BUF  164  // four telemetry frames
+#define TX_LOG_BUF     255
+#define TX_MSG_MAX     64   // TxLine buffer; longer lines are queued in pieces
+
+enum TxChannel : uint8_t {
+  TX_REPLY,
+  TX_STREAM,
+  TX_LOG,
+  TX_CHANNEL_COUNT
+};
+
+// Queues len bytes as one message. Returns false if it was dropped.
+bool txQueue(TxChannel ch, const uint8_t* data, uint8_t len, bool mustSend = false);
+uint8_t txRoom(TxChannel ch);  // largest message that fits without dropping or waiting
+void txDrain();                // every loop(); also run after each txQueue
+
+// print() into a line buffer; each '\n' queues the line as one message, and whatever is left is
+// queued when the TxLine goes out of scope.
+class TxLine : public Print {
+public:
+  explicit TxLine(TxChannel ch, bool mustSend = false) : ch_(ch), mustSend_(mustSend), len_(0) {}
+  ~TxLine() { send(); }
+  size_t write(uint8_t c) override;
+  using Print::write;
+  void send();
+
+private:
+  TxChannel ch_;
+  bool mustSend_;
+  uint8_t len_;
+  uint8_t buf_[TX_MSG_MAX];
+};
+
+extern unsigned long txDropped[TX_CHANNEL_COUNT];  // messages dropped per channel
+extern unsigned long txWaits;                      // messages that had to wait for the UART
+
+#endif
@@ -8,25 +8,20 @@ int clampInt(int v, int mn, int mx) {
   return v;
 }
 
-float clampFloat(float v, float mn, float mx) {
-  if (v < mn) return mn;
-  if (v > mx) return mx;
-  return v;
-}
-
-float joyToNorm(int raw) {
+// 10-bit ADC: raw 512 ± 512 maps exactly to ±Q16_ONE (x128)
+q16_t joyToNorm(int raw) {
   int d = raw - 512;
-  if (abs(d) < DEADZONE) return 0.0f;
-  float n = (float)d / 512.0f;
-  return clampFloat(n, -1.0f, 1.0f);
+  if (abs(d) < DEADZONE) return 0;
+  return q16Clamp((q16_t)d * 128L, -Q16_ONE, Q16_ONE);
 }
 
-void applyIncremental(float &value, float stickNorm) {
-  float mag = abs(stickNorm);
-  if (mag < 0.05f) return;
+// step is AIM_STEP for one ~25 ms pass; faster callers pass CONTROL_TICK_SCALE(AIM_STEP).
+void applyIncremental(q16_t &value, q16_t stickNorm, q16_t step) {
+  q16_t mag = q16Abs(stickNorm);
+  if (mag < Q16(0.05)) return;
 
-  float mult = 1.0f + (mag * AIM_FAST);
-  float delta = stickNorm * AIM_STEP * mult;
+  q16_t mult = Q16_ONE + q16Mul(mag, AIM_FAST);
+  q16_t delta = q16Mul(q16Mul(stickNorm, step), mult);
 
-  value = clampFloat(value + delta, -1.0f, 1.0f);
+  value = q16Clamp(value + delta, -Q16_ONE, Q16_ONE);
 }
@@ -1,9 +1,10 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "config.h"
+
 int clampInt(int v, int mn, int mx);
-float clampFloat(float v, float mn, float mx);
-float joyToNorm(int raw);
-void applyIncremental(float &value, float stickNorm);
+q16_t joyToNorm(int raw);
+void applyIncremental(q16_t &value, q16_t stickNorm, q16_t step = AIM_STEP);
 
 #endif
@@ -0,0 +1,131 @@
+// Host benchmark for the launcher spin mixing: the table/fixed-point getLauncherMotorSpeeds()
+// against the previous float path (three cos() calls per update, copied below as reference).
+// Also checks every (power, spinMode, intensity) input for differences between the two. They
+// differ by one count at rounding ties, and by at most two counts when the speed goes negative:
+// the float path truncates (int)(x + 0.5) toward zero there while the table path rounds to
+// nearest, and near a .5 tie the Q22 drop factor and float cos() can round apart on top of that.
+// The table path keeps its product in uint32_t with no long in the expression, so the host wraps
+// exactly where the Mega's 32-bit accumulator would; an overflow shows up here as a full-scale
+// difference, and a difference of more than two counts fails the run.
+//
+// Host cycles say nothing absolute about the AVR (no FPU there, so the float path is far
+// slower); the ratio and the equivalence check are what this is for.
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "motors.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycleNow() { return __rdtsc(); }
+static const char* const CYCLE_UNIT = "TSC cycles";
+#else
+static inline uint64_t cycleNow() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static const char* const CYCLE_UNIT = "ns";
+#endif
+
+namespace {
+
+// ---- Reference: float path as it was before the lookup table ----
+float legacySpinAlign(float motorDeg, float targetRad) {
+  float diffRad = (motorDeg * 0.01745329252f) - targetRad;
+  float c = (float)cos((double)diffRad);
+  return (c + 1.0f) * 0.5f;
+}
+
+void legacyLauncherSpeeds(int power, SpinMode spinMode, int spinIntensity, int& s1, int& s2, int& s3) {
+  s1 = s2 = s3 = power;
+  int targetAngle = spinModeToAngleDeg(spinMode);
+  if (targetAngle >= 0 && spinIntensity != 0) {
+    float k = (float)spinIntensity / 255.0f;
+    float targetRad = (float)targetAngle * 0.01745329252f;
+    float a1 = legacySpinAlign(0.0f, targetRad);
+    float a2 = legacySpinAlign(120.0f, targetRad);
+    float a3 = legacySpinAlign(240.0f, targetRad);
+    s1 = (int)(power * (1.0f - k * (1.0f - a1)) + 0.5f);
+    s2 = (int)(power * (1.0f - k * (1.0f - a2)) + 0.5f);
+    s3 = (int)(power * (1.0f - k * (1.0f - a3)) + 0.5f);
+  }
+  s1 = s1 < -255 ? -255 : s1 > 255 ? 255 : s1;
+  s2 = s2 < -255 ? -255 : s2 > 255 ? 255 : s2;
+  s3 = s3 < -255 ? -255 : s3 > 255 ? 255 : s3;
+}
+
+struct Input {
+  int power;
+  SpinMode mode;
+  int intensity;
+};
+
+volatile int g_sink;
+
+template <typename Fn>
+double cyclesPerCall(const std::vector<Input>& in, int rounds, Fn fn) {
+  uint64_t best = ~0ULL;
+  for (int r = 0; r < rounds; r++) {
+    uint64_t t0 = cycleNow();
+    int acc = 0;
+    for (const Input& x : in) {
+      int a, b, c;
+      fn(x.power, x.mode, x.intensity, a, b, c);
+      acc += a ^ b ^ c;
+    }
+    uint64_t t1 = cycleNow();
+    g_sink = acc;
+    if (t1 - t0 < best) best = t1 - t0;
+  }
+  return (double)best / (double)in.size();
+}
+
+}  // namespace
+
+int main() {
+  // Equivalence over the whole input space the app and menus can produce.
+  unsigned long total = 0, differ = 0, differNegative = 0;
+  int maxDiff = 0;
+  for (int m = 0; m < SPIN_MODE_COUNT; m++) {
+    for (int power = 0; power <= 255; power++) {
+      for (int intensity = 0; intensity <= 512; intensity++) {
+        int a[3], b[3];
+        legacyLauncherSpeeds(power, (SpinMode)m, intensity, a[0], a[1], a[2]);
+        getLauncherMotorSpeeds(power, (SpinMode)m, intensity, b[0], b[1], b[2]);
+        for (int i = 0; i < 3; i++) {
+          total++;
+          int d = abs(a[i] - b[i]);
+          if (d) {
+            differ++;
+            if (b[i] < 0) differNegative++;
+          }
+          if (d > maxDiff) maxDiff = d;
+        }
+      }
+    }
+  }
+  printf("equivalence: %lu motor speeds, %lu differ (%lu of them negative), max |diff| %d\n", total, differ,
+         differNegative, maxDiff);
+  if (maxDiff > 2) {
+    printf("FAIL: table path is off by more than rounding (32-bit accumulator overflow?)\n");
+    return 1;
+  }
+
+  std::vector<Input> in;
+  srand(1);
+  for (int i = 0; i < 4096; i++) {
+    in.push_back(Input{ rand() % 256, (SpinMode)(rand() % SPIN_MODE_COUNT), rand() % 513 });
+  }
+  double legacy = cyclesPerCall(in, 50, legacyLauncherSpeeds);
+  double table = cyclesPerCall(in, 50, getLauncherMotorSpeeds);
+  printf("float cos path : %8.1f %s per update\n", legacy, CYCLE_UNIT);
+  printf("table path     : %8.1f %s per update (%.1fx)\n", table, CYCLE_UNIT, table > 0 ? legacy / table : 0.0);
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SIM_AFMOTOR_R4_H
+#define SIM_AFMOTOR_R4_H
+
+#include "Arduino.h"
+
+#define MOTOR12_64KHZ 1
+#define MOTOR12_8KHZ  2
+#define MOTOR12_2KHZ  3
+#define MOTOR12_1KHZ  4
+#define MOTOR34_64KHZ 1
+#define MOTOR34_8KHZ  2
+#define MOTOR34_1KHZ  3
+
+#define FORWARD  1
+#define BACKWARD 2
+#define BRAKE    3
+#define RELEASE  4
+
+// Host stand-in for the Adafruit motor shield v1 DC motor driver. run() is charged as a
+// 74HC595 latch update; the last speed/command per channel is visible to the simulator.
+class AF_DCMotor {
+public:
+  AF_DCMotor(uint8_t motornum, uint8_t freq = MOTOR34_8KHZ);
+  void run(uint8_t cmd);
+  void setSpeed(uint8_t speed);
+
+private:
+  uint8_t motornum_;
+};
+
+#endif
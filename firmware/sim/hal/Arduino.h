@@ -0,0 +1,75 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+// Host stand-in for the Arduino AVR core, just enough of it for the firmware in
+// ../ping-pong-robot to build and run unmodified. Time is virtual: millis()/micros() read the
+// simulator clock (see sim_hal.h), and delay() advances it instead of sleeping.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define LED_BUILTIN 13
+
+// Arduino Mega 2560 analog pin numbering
+#define A0  54
+#define A1  55
+#define A2  56
+#define A3  57
+#define A4  58
+#define A5  59
+#define A6  60
+#define A7  61
+#define A8  62
+#define A9  63
+#define A10 64
+#define A11 65
+#define A12 66
+#define A13 67
+#define A14 68
+#define A15 69
+
+#define SIM_NUM_PINS 70
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+#define interrupts()   sei()
+#define noInterrupts() cli()
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+// Same generator as avr-libc random() so a given seed yields the same sequence as the robot.
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+void setup(void);
+void loop(void);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+#include "Arduino.h"
+#include <avr/eeprom.h>
+
+#define SIM_EEPROM_SIZE 4096  // ATmega2560
+
+// Host stand-in for the AVR EEPROM library. Erased cells read 0xFF. A write starts a 3.3 ms
+// programming cycle and returns; the next read or write waits for it, as on the AVR
+// (eeprom_is_ready() in avr/eeprom.h tells when it is over). Writes are counted per cell so wear
+// can be inspected.
+class EEPROMClass {
+public:
+  uint8_t read(int idx);
+  void write(int idx, uint8_t val);
+  void update(int idx, uint8_t val);
+  uint16_t length() { return SIM_EEPROM_SIZE; }
+
+  template <typename T>
+  T& get(int idx, T& t) {
+    uint8_t* ptr = (uint8_t*)&t;
+    for (int count = sizeof(T); count; --count, ++idx) *ptr++ = read(idx);
+    return t;
+  }
+
+  template <typename T>
+  const T& put(int idx, const T& t) {
+    const uint8_t* ptr = (const uint8_t*)&t;
+    for (int count = sizeof(T); count; --count, ++idx) update(idx, *ptr++);
+    return t;
+  }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SIM_HARDWARESERIAL_H
+#define SIM_HARDWARESERIAL_H
+
+#include "Stream.h"
+#include <vector>
+
+#define SERIAL_TX_BUFFER_SIZE 64
+#define SERIAL_RX_BUFFER_SIZE 64
+
+// UART model with the AVR core's 64-byte TX/RX rings. Bytes leave at the configured baud rate
+// in virtual time; write() on a full TX ring advances the clock exactly like the real
+// busy-wait, so logging cost shows up in loop timing. RX bytes injected by the simulator
+// arrive at line rate and are dropped when the ring is full, as on the Mega.
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int port);
+
+  void begin(unsigned long baud);
+  void begin(unsigned long baud, uint8_t config) { (void)config; begin(baud); }
+  void end();
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() override;
+  void flush() override;
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  operator bool() const { return true; }
+
+  // ---- simulator side ----
+  unsigned long baud() const { return baud_; }
+  void simInject(const uint8_t* data, size_t len);
+  unsigned long simDroppedRx() const { return droppedRx_; }
+  unsigned long simTxBytes() const { return txBytes_; }
+  unsigned long simTxStallUs() const { return txStallUs_; }
+  void simSetTxSink(void (*sink)(int port, uint8_t c)) { sink_ = sink; }
+
+private:
+  unsigned long byteUs() const;
+  void pumpRx();
+
+  int port_;
+  unsigned long baud_ = 0;
+  uint64_t txBusyUntilUs_ = 0;
+  unsigned long txBytes_ = 0;
+  unsigned long txStallUs_ = 0;
+
+  uint8_t rx_[SERIAL_RX_BUFFER_SIZE];
+  int rxHead_ = 0;
+  int rxCount_ = 0;
+  unsigned long droppedRx_ = 0;
+
+  struct Pending {
+    uint8_t c;
+    uint64_t atUs;
+  };
+  std::vector<Pending> pending_;
+  size_t pendingPos_ = 0;
+  uint64_t lastArrivalUs_ = 0;
+
+  void (*sink_)(int port, uint8_t c) = nullptr;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef SIM_SERVO_H
+#define SIM_SERVO_H
+
+#include "Arduino.h"
+
+#define MIN_PULSE_WIDTH 544
+#define MAX_PULSE_WIDTH 2400
+#define DEFAULT_PULSE_WIDTH 1500
+#define MAX_SERVOS 12
+
+// Host stand-in for the Servo library; keeps the commanded pulse width so the simulator can
+// report where the head is pointing.
+class Servo {
+public:
+  uint8_t attach(int pin);
+  uint8_t attach(int pin, int min, int max);
+  void detach();
+  void write(int value);
+  void writeMicroseconds(int value);
+  int read();
+  int readMicroseconds();
+  bool attached();
+
+  int simPin() const { return pin_; }
+
+private:
+  int pin_ = -1;
+  int min_ = MIN_PULSE_WIDTH;
+  int max_ = MAX_PULSE_WIDTH;
+  int us_ = DEFAULT_PULSE_WIDTH;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+#define WIRE_HAS_END 1
+
+// I2C master with the AVR Wire library's 32-byte transmit buffer. endTransmission() charges
+// the bus time for the bytes sent at the current clock rate and hands them to the simulated
+// device at that address (only the SSD1306 at 0x3C/0x3D is modelled).
+class TwoWire : public Stream {
+public:
+  void begin();
+  void end() {}
+  void setClock(uint32_t clock);
+  uint32_t clock() const { return clock_; }
+
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  uint8_t endTransmission(bool sendStop = true);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t* data, size_t quantity) override;
+  using Print::write;
+
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() override {}
+
+private:
+  uint32_t clock_ = 100000UL;
+  uint8_t address_ = 0;
+  bool transmitting_ = false;
+  uint8_t buf_[BUFFER_LENGTH];
+  uint8_t len_ = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
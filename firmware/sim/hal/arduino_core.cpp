@@ -0,0 +1,472 @@
+#include "Arduino.h"
+#include "sim_hal.h"
+
+#include <chrono>
+#include <map>
+
+// ================= Virtual clock =================
+namespace {
+
+uint64_t g_nowUs = 0;
+uint32_t g_cpuScalePermille = 0;
+std::chrono::steady_clock::time_point g_hostMark;
+
+struct TimedInput {
+  uint8_t pin;
+  int level;
+};
+std::multimap<uint64_t, TimedInput> g_timedInputs;
+bool g_inTimedInput = false;
+
+// Every forward move of the clock goes through here: it stops at each scheduled input change on
+// the way, so an ISR the change triggers reads the exact time.
+void moveClockTo(uint64_t us) {
+  while (!g_inTimedInput && !g_timedInputs.empty() && g_timedInputs.begin()->first <= us) {
+    auto it = g_timedInputs.begin();
+    if (it->first > g_nowUs) g_nowUs = it->first;
+    const TimedInput in = it->second;
+    g_timedInputs.erase(it);
+    g_inTimedInput = true;
+    sim::setDigitalInput(in.pin, in.level);
+    g_inTimedInput = false;
+  }
+  if (us > g_nowUs) g_nowUs = us;
+}
+
+int g_digitalIn[SIM_NUM_PINS];
+int g_analogIn[SIM_NUM_PINS];
+int g_digitalOut[SIM_NUM_PINS];
+int g_analogOut[SIM_NUM_PINS];
+uint8_t g_pinMode[SIM_NUM_PINS];
+
+struct PinDefaults {
+  PinDefaults() {
+    for (int i = 0; i < SIM_NUM_PINS; i++) {
+      g_digitalIn[i] = LOW;
+      g_analogIn[i] = 512;  // joystick axes rest at mid-scale
+      g_digitalOut[i] = LOW;
+      g_analogOut[i] = 0;
+      g_pinMode[i] = INPUT;
+    }
+    g_hostMark = std::chrono::steady_clock::now();
+  }
+} g_pinDefaults;
+
+bool validPin(uint8_t pin) {
+  return pin < SIM_NUM_PINS;
+}
+
+// Pin-change interrupt on port K (A8..A15); the vector is defined by the firmware when it uses it
+bool g_irqEnabled = true;
+bool g_pcint2Pending = false;
+
+}  // namespace
+
+volatile uint8_t PCICR = 0;
+volatile uint8_t PCMSK2 = 0;
+extern "C" void PCINT2_vect(void) __attribute__((weak));
+
+namespace {
+
+void firePcint2() {
+  if (!g_irqEnabled) {
+    g_pcint2Pending = true;
+    return;
+  }
+  g_irqEnabled = false;  // as on the AVR, an ISR runs with interrupts off
+  PCINT2_vect();
+  g_irqEnabled = true;
+}
+
+void pinChanged(uint8_t pin) {
+  if (pin < A8 || pin > A15 || !PCINT2_vect) return;
+  if ((PCICR & (1 << PCIE2)) && (PCMSK2 & (1 << (pin - A8)))) firePcint2();
+}
+
+}  // namespace
+
+uint8_t simReadPortK() {
+  uint8_t v = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (g_digitalIn[A8 + i]) v |= (uint8_t)(1 << i);
+  }
+  return v;
+}
+
+void cli(void) {
+  g_irqEnabled = false;
+}
+
+void sei(void) {
+  g_irqEnabled = true;
+  if (g_pcint2Pending) {
+    g_pcint2Pending = false;
+    firePcint2();
+  }
+}
+
+namespace sim {
+
+uint64_t nowUs() {
+  return g_nowUs;
+}
+
+void advanceUs(uint64_t us) {
+  moveClockTo(g_nowUs + us);
+}
+
+void advanceToUs(uint64_t us) {
+  moveClockTo(us);
+}
+
+void scheduleDigitalInput(uint8_t pin, int level, uint64_t atUs) {
+  if (atUs <= g_nowUs) {
+    setDigitalInput(pin, level);
+    return;
+  }
+  g_timedInputs.emplace(atUs, TimedInput{ pin, level });
+}
+
+void setCpuScalePermille(uint32_t permille) {
+  g_cpuScalePermille = permille;
+  g_hostMark = std::chrono::steady_clock::now();
+}
+
+void syncCpu() {
+  if (g_cpuScalePermille == 0) return;
+  auto host = std::chrono::steady_clock::now();
+  uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(host - g_hostMark).count();
+  g_hostMark = host;
+  moveClockTo(g_nowUs + ns * g_cpuScalePermille / 1000000ULL);
+}
+
+void setDigitalInput(uint8_t pin, int level) {
+  if (!validPin(pin)) return;
+  const int old = g_digitalIn[pin];
+  g_digitalIn[pin] = level ? HIGH : LOW;
+  if (g_digitalIn[pin] != old) pinChanged(pin);
+}
+
+void setAnalogInput(uint8_t pin, int value) {
+  if (!validPin(pin)) return;
+  if (value < 0) value = 0;
+  if (value > 1023) value = 1023;
+  g_analogIn[pin] = value;
+}
+
+int digitalOutput(uint8_t pin) {
+  return validPin(pin) ? g_digitalOut[pin] : LOW;
+}
+
+int analogOutput(uint8_t pin) {
+  return validPin(pin) ? g_analogOut[pin] : 0;
+}
+
+CostModel& costs() {
+  static CostModel c;
+  return c;
+}
+
+Counters& counters() {
+  static Counters c;
+  return c;
+}
+
+}  // namespace sim
+
+unsigned long millis(void) {
+  sim::syncCpu();
+  return (unsigned long)(g_nowUs / 1000ULL);
+}
+
+unsigned long micros(void) {
+  sim::syncCpu();
+  return (unsigned long)g_nowUs;
+}
+
+void delay(unsigned long ms) {
+  sim::syncCpu();
+  moveClockTo(g_nowUs + (uint64_t)ms * 1000ULL);
+}
+
+void delayMicroseconds(unsigned int us) {
+  sim::syncCpu();
+  moveClockTo(g_nowUs + us);
+}
+
+// ================= Pins =================
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (!validPin(pin)) return;
+  g_pinMode[pin] = mode;
+  if (mode == INPUT_PULLUP) g_digitalIn[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  sim::syncCpu();
+  moveClockTo(g_nowUs + sim::costs().digitalIoUs);
+  if (validPin(pin)) g_digitalOut[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  sim::syncCpu();
+  moveClockTo(g_nowUs + sim::costs().digitalIoUs);
+  return validPin(pin) ? g_digitalIn[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  sim::syncCpu();
+  moveClockTo(g_nowUs + sim::costs().analogReadUs);
+  sim::counters().analogReads++;
+  return validPin(pin) ? g_analogIn[pin] : 0;
+}
+
+void analogWrite(uint8_t pin, int val) {
+  if (validPin(pin)) g_analogOut[pin] = val;
+}
+
+// ================= random() =================
+// avr-libc do_random(): Park-Miller minimal standard generator on 32-bit longs.
+static uint32_t g_randomNext = 1;
+
+static int32_t avrRandom(void) {
+  int32_t x = (int32_t)g_randomNext;
+  if (x == 0) x = 123459876L;
+  int32_t hi = x / 127773L;
+  int32_t lo = x % 127773L;
+  x = 16807L * lo - 2836L * hi;
+  if (x < 0) x += 0x7fffffffL;
+  g_randomNext = (uint32_t)x;
+  return (int32_t)((uint32_t)x % (0x7fffffffUL + 1UL));
+}
+
+long random(long howbig) {
+  if (howbig == 0) return 0;
+  return (long)(avrRandom() % (int32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  long diff = howbig - howsmall;
+  return random(diff) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) g_randomNext = (uint32_t)seed;
+}
+
+// ================= Print =================
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (write(*buffer++)) n++;
+    else break;
+  }
+  return n;
+}
+
+size_t Print::write(const char* str) {
+  if (str == nullptr) return 0;
+  return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::print(const __FlashStringHelper* s) {
+  return write(reinterpret_cast<const char*>(s));
+}
+
+size_t Print::print(const char s[]) {
+  return write(s);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(int n, int base) {
+  return print((long)n, base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 0) return write((uint8_t)n);
+  if (base == 10 && n < 0) {
+    size_t t = print('-');
+    return printNumber((unsigned long)(-n), 10) + t;
+  }
+  return printNumber((unsigned long)n, (uint8_t)base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  if (base == 0) return write((uint8_t)n);
+  return printNumber(n, (uint8_t)base);
+}
+
+size_t Print::print(double n, int digits) {
+  return printFloat(n, (uint8_t)digits);
+}
+
+size_t Print::println(void) {
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper* s) { size_t n = print(s); return n + println(); }
+size_t Print::println(const char s[]) { size_t n = print(s); return n + println(); }
+size_t Print::println(char c) { size_t n = print(c); return n + println(); }
+size_t Print::println(unsigned char b, int base) { size_t n = print(b, base); return n + println(); }
+size_t Print::println(int num, int base) { size_t n = print(num, base); return n + println(); }
+size_t Print::println(unsigned int num, int base) { size_t n = print(num, base); return n + println(); }
+size_t Print::println(long num, int base) { size_t n = print(num, base); return n + println(); }
+size_t Print::println(unsigned long num, int base) { size_t n = print(num, base); return n + println(); }
+size_t Print::println(double num, int digits) { size_t n = print(num, digits); return n + println(); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char buf[8 * sizeof(long) + 1];
+  char* str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = (char)(n % base);
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits) {
+  size_t n = 0;
+  if (isnan(number)) return print("nan");
+  if (isinf(number)) return print("inf");
+  if (number > 4294967040.0) return print("ovf");
+  if (number < -4294967040.0) return print("ovf");
+
+  if (number < 0.0) {
+    n += print('-');
+    number = -number;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i) rounding /= 10.0;
+  number += rounding;
+
+  unsigned long intPart = (unsigned long)number;
+  double remainder = number - (double)intPart;
+  n += print(intPart);
+
+  if (digits > 0) n += print('.');
+  while (digits-- > 0) {
+    remainder *= 10.0;
+    unsigned int toPrint = (unsigned int)remainder;
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+  return n;
+}
+
+// ================= HardwareSerial =================
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+HardwareSerial Serial3(3);
+
+HardwareSerial::HardwareSerial(int port) : port_(port) {}
+
+void HardwareSerial::begin(unsigned long baud) {
+  baud_ = baud;
+  txBusyUntilUs_ = g_nowUs;
+}
+
+void HardwareSerial::end() {
+  baud_ = 0;
+}
+
+unsigned long HardwareSerial::byteUs() const {
+  if (baud_ == 0) return 0;
+  return (10UL * 1000000UL + baud_ - 1) / baud_;  // 8N1: start + 8 data + stop
+}
+
+void HardwareSerial::pumpRx() {
+  while (pendingPos_ < pending_.size() && pending_[pendingPos_].atUs <= g_nowUs) {
+    if (rxCount_ < SERIAL_RX_BUFFER_SIZE) {
+      rx_[(rxHead_ + rxCount_) % SERIAL_RX_BUFFER_SIZE] = pending_[pendingPos_].c;
+      rxCount_++;
+    } else {
+      droppedRx_++;
+    }
+    pendingPos_++;
+  }
+  if (pendingPos_ == pending_.size()) {
+    pending_.clear();
+    pendingPos_ = 0;
+  }
+}
+
+int HardwareSerial::available() {
+  sim::syncCpu();
+  pumpRx();
+  return rxCount_;
+}
+
+int HardwareSerial::peek() {
+  pumpRx();
+  if (rxCount_ == 0) return -1;
+  return rx_[rxHead_];
+}
+
+int HardwareSerial::read() {
+  pumpRx();
+  if (rxCount_ == 0) return -1;
+  uint8_t c = rx_[rxHead_];
+  rxHead_ = (rxHead_ + 1) % SERIAL_RX_BUFFER_SIZE;
+  rxCount_--;
+  return c;
+}
+
+int HardwareSerial::availableForWrite() {
+  unsigned long per = byteUs();
+  if (per == 0 || txBusyUntilUs_ <= g_nowUs) return SERIAL_TX_BUFFER_SIZE - 1;
+  uint64_t queued = (txBusyUntilUs_ - g_nowUs + per - 1) / per;
+  if (queued >= SERIAL_TX_BUFFER_SIZE - 1) return 0;
+  return (int)(SERIAL_TX_BUFFER_SIZE - 1 - queued);
+}
+
+void HardwareSerial::flush() {
+  if (txBusyUntilUs_ > g_nowUs) {
+    txStallUs_ += (unsigned long)(txBusyUntilUs_ - g_nowUs);
+    moveClockTo(txBusyUntilUs_);
+  }
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  sim::syncCpu();
+  unsigned long per = byteUs();
+  if (per > 0) {
+    // Ring full: the AVR core spins until the UDRE interrupt frees one slot.
+    uint64_t limit = (uint64_t)(SERIAL_TX_BUFFER_SIZE - 1) * per;
+    if (txBusyUntilUs_ > g_nowUs + limit) {
+      uint64_t freeAt = txBusyUntilUs_ - limit;
+      txStallUs_ += (unsigned long)(freeAt - g_nowUs);
+      moveClockTo(freeAt);
+    }
+    uint64_t start = txBusyUntilUs_ > g_nowUs ? txBusyUntilUs_ : g_nowUs;
+    txBusyUntilUs_ = start + per;
+  }
+  txBytes_++;
+  if (sink_) sink_(port_, c);
+  return 1;
+}
+
+void HardwareSerial::simInject(const uint8_t* data, size_t len) {
+  unsigned long per = byteUs();
+  uint64_t t = lastArrivalUs_ > g_nowUs ? lastArrivalUs_ : g_nowUs;
+  for (size_t i = 0; i < len; i++) {
+    t += per;
+    pending_.push_back(Pending{ data[i], t });
+  }
+  lastArrivalUs_ = t;
+}
@@ -0,0 +1,9 @@
+#ifndef SIM_AVR_EEPROM_H
+#define SIM_AVR_EEPROM_H
+
+// Host stand-in for avr-libc <avr/eeprom.h>: eeprom_is_ready() is false while the last EEPROM
+// write is still programming (EEPE set), as modelled in devices.cpp.
+
+bool eeprom_is_ready();
+
+#endif
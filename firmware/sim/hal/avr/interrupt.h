@@ -0,0 +1,12 @@
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+// Host stand-in for avr-libc <avr/interrupt.h>. ISR(v) defines a plain function the simulator
+// calls when the interrupt fires; with interrupts off (cli) it is held until sei().
+
+#define ISR(vector) extern "C" void vector(void); extern "C" void vector(void)
+
+void cli(void);
+void sei(void);
+
+#endif
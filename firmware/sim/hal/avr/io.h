@@ -0,0 +1,17 @@
+#ifndef SIM_AVR_IO_H
+#define SIM_AVR_IO_H
+
+// Host stand-in for the few ATmega2560 registers the firmware touches: the port K pin-change
+// interrupt (PCINT16..23 on A8..A15). PINK reads the simulated pin levels; a level change on a
+// masked pin runs PCINT2_vect from sim::setDigitalInput().
+
+#include <stdint.h>
+
+extern volatile uint8_t PCICR;
+extern volatile uint8_t PCMSK2;
+uint8_t simReadPortK();
+
+#define PINK  (simReadPortK())
+#define PCIE2 2
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SIM_AVR_PGMSPACE_H
+#define SIM_AVR_PGMSPACE_H
+
+// Host stand-in for avr-libc <avr/pgmspace.h>. Flash and RAM share one address space on the
+// host, so PROGMEM is a no-op and the pgm_read_* helpers are plain loads.
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_ptr(addr)   (*(const void* const*)(addr))
+
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+// avr-libc declares these in <stdio.h>; the format string is in flash
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+
+#endif
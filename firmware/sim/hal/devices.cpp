@@ -0,0 +1,180 @@
+#include "AFMotor_R4.h"
+#include "EEPROM.h"
+#include "Servo.h"
+#include "sim_hal.h"
+
+#include <stdio.h>
+
+// ================= Servo =================
+namespace {
+
+const int MAX_SIM_SERVOS = MAX_SERVOS;
+Servo* g_servos[MAX_SIM_SERVOS] = { nullptr };
+
+long mapLong(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+}  // namespace
+
+uint8_t Servo::attach(int pin) {
+  return attach(pin, MIN_PULSE_WIDTH, MAX_PULSE_WIDTH);
+}
+
+uint8_t Servo::attach(int pin, int min, int max) {
+  pin_ = pin;
+  min_ = min;
+  max_ = max;
+  for (int i = 0; i < MAX_SIM_SERVOS; i++) {
+    if (g_servos[i] == this) return (uint8_t)i;
+  }
+  for (int i = 0; i < MAX_SIM_SERVOS; i++) {
+    if (g_servos[i] == nullptr) {
+      g_servos[i] = this;
+      return (uint8_t)i;
+    }
+  }
+  return 255;
+}
+
+void Servo::detach() {
+  for (int i = 0; i < MAX_SIM_SERVOS; i++) {
+    if (g_servos[i] == this) g_servos[i] = nullptr;
+  }
+  pin_ = -1;
+}
+
+void Servo::write(int value) {
+  if (value < MIN_PULSE_WIDTH) {
+    if (value < 0) value = 0;
+    if (value > 180) value = 180;
+    value = (int)mapLong(value, 0, 180, min_, max_);
+  }
+  writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int value) {
+  if (value < min_) value = min_;
+  if (value > max_) value = max_;
+  sim::syncCpu();
+  sim::advanceUs(sim::costs().servoWriteUs);
+  sim::counters().servoWrites++;
+  us_ = value;
+}
+
+int Servo::read() {
+  return (int)mapLong(readMicroseconds() + 1, min_, max_, 0, 180);
+}
+
+int Servo::readMicroseconds() {
+  return us_;
+}
+
+bool Servo::attached() {
+  return pin_ >= 0;
+}
+
+int sim::servoMicrosOnPin(int pin) {
+  for (int i = 0; i < MAX_SIM_SERVOS; i++) {
+    if (g_servos[i] != nullptr && g_servos[i]->attached() && g_servos[i]->simPin() == pin) {
+      return g_servos[i]->readMicroseconds();
+    }
+  }
+  return 0;
+}
+
+// ================= AF_DCMotor =================
+namespace {
+
+sim::MotorState g_motors[5] = { { 0, RELEASE }, { 0, RELEASE }, { 0, RELEASE }, { 0, RELEASE }, { 0, RELEASE } };
+
+}  // namespace
+
+AF_DCMotor::AF_DCMotor(uint8_t motornum, uint8_t freq) : motornum_(motornum) {
+  (void)freq;
+}
+
+void AF_DCMotor::run(uint8_t cmd) {
+  sim::syncCpu();
+  sim::advanceUs(sim::costs().motorRunUs);
+  sim::counters().motorRuns++;
+  if (motornum_ >= 1 && motornum_ <= 4) g_motors[motornum_].command = cmd;
+}
+
+void AF_DCMotor::setSpeed(uint8_t speed) {
+  sim::syncCpu();
+  sim::advanceUs(sim::costs().motorSetSpeedUs);
+  sim::counters().motorSetSpeeds++;
+  if (motornum_ >= 1 && motornum_ <= 4) g_motors[motornum_].speed = speed;
+}
+
+sim::MotorState sim::motorState(int num) {
+  if (num < 1 || num > 4) return sim::MotorState{ 0, RELEASE };
+  return g_motors[num];
+}
+
+// ================= EEPROM =================
+EEPROMClass EEPROM;
+
+namespace {
+
+struct EepromCells {
+  EepromCells() { memset(data, 0xFF, sizeof(data)); }
+  uint8_t data[SIM_EEPROM_SIZE];
+  unsigned long writes[SIM_EEPROM_SIZE] = { 0 };
+  uint64_t busyUntilUs = 0;  // end of the programming cycle of the last write
+} g_eeprom;
+
+// Like eeprom_read_byte / eeprom_write_byte: wait for the previous write to finish
+void waitEepromReady() {
+  sim::syncCpu();
+  if (sim::nowUs() < g_eeprom.busyUntilUs) sim::advanceToUs(g_eeprom.busyUntilUs);
+}
+
+}  // namespace
+
+bool eeprom_is_ready() {
+  sim::syncCpu();
+  return sim::nowUs() >= g_eeprom.busyUntilUs;
+}
+
+uint8_t EEPROMClass::read(int idx) {
+  if (idx < 0 || idx >= SIM_EEPROM_SIZE) return 0xFF;
+  waitEepromReady();
+  sim::advanceUs(sim::costs().eepromReadUs);
+  return g_eeprom.data[idx];
+}
+
+void EEPROMClass::write(int idx, uint8_t val) {
+  if (idx < 0 || idx >= SIM_EEPROM_SIZE) return;
+  waitEepromReady();
+  g_eeprom.busyUntilUs = sim::nowUs() + sim::costs().eepromWriteUs;
+  sim::counters().eepromWrites++;
+  g_eeprom.data[idx] = val;
+  g_eeprom.writes[idx]++;
+}
+
+void EEPROMClass::update(int idx, uint8_t val) {
+  if (read(idx) != val) write(idx, val);
+}
+
+bool sim::loadEeprom(const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  size_t n = fread(g_eeprom.data, 1, SIM_EEPROM_SIZE, f);
+  fclose(f);
+  return n == SIM_EEPROM_SIZE;
+}
+
+bool sim::saveEeprom(const char* path) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  size_t n = fwrite(g_eeprom.data, 1, SIM_EEPROM_SIZE, f);
+  fclose(f);
+  return n == SIM_EEPROM_SIZE;
+}
+
+unsigned long sim::eepromCellWrites(int addr) {
+  if (addr < 0 || addr >= SIM_EEPROM_SIZE) return 0;
+  return g_eeprom.writes[addr];
+}
@@ -0,0 +1,76 @@
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+// Simulator-side controls for the fake Arduino HAL: the virtual clock, input injection and the
+// cost model that charges virtual time for slow peripherals. Firmware code never includes this.
+
+#include <stdint.h>
+
+namespace sim {
+
+// ---- Virtual clock ----
+uint64_t nowUs();
+void advanceUs(uint64_t us);
+void advanceToUs(uint64_t us);
+
+// Optional CPU model: host nanoseconds spent inside firmware code are multiplied by this factor
+// (per mille, 0 = off) and charged to the virtual clock. Off by default so runs are
+// deterministic; a scale around 40000 roughly matches a 16 MHz AVR against a desktop core.
+void setCpuScalePermille(uint32_t permille);
+void syncCpu();
+
+// ---- Pins ----
+void setDigitalInput(uint8_t pin, int level);
+void setAnalogInput(uint8_t pin, int value);
+// Input change at a later virtual time; the clock stops there on its way forward, so an ISR it
+// triggers (pin-change) reads the exact micros() even in the middle of a long I2C transfer.
+void scheduleDigitalInput(uint8_t pin, int level, uint64_t atUs);
+int digitalOutput(uint8_t pin);
+int analogOutput(uint8_t pin);
+
+// ---- Cost model (virtual microseconds charged per call) ----
+struct CostModel {
+  uint32_t analogReadUs = 112;       // ADC conversion at the default prescaler
+  uint32_t digitalIoUs = 4;          // digitalRead/digitalWrite pin lookup
+  uint32_t motorRunUs = 110;         // AFMotor latch_tx(): 8 bits shifted into the 74HC595
+  uint32_t motorSetSpeedUs = 6;      // PWM compare register write
+  uint32_t servoWriteUs = 8;         // Servo.write(): map + timer slot update
+  uint32_t eepromWriteUs = 3300;     // erase + write cycle; the next EEPROM access waits for it
+  uint32_t eepromReadUs = 2;
+  uint32_t i2cTransactionUs = 30;    // start/address/stop and Wire library overhead
+};
+CostModel& costs();
+
+// ---- Counters ----
+struct Counters {
+  unsigned long analogReads = 0;
+  unsigned long i2cTransactions = 0;
+  unsigned long i2cBytes = 0;
+  uint64_t i2cBusUs = 0;
+  unsigned long eepromWrites = 0;
+  unsigned long servoWrites = 0;
+  unsigned long motorRuns = 0;
+  unsigned long motorSetSpeeds = 0;
+};
+Counters& counters();
+
+// ---- SSD1306 panel (what is actually shown, as received over I2C) ----
+const uint8_t* panelRam();  // 128x64, same page layout as the Adafruit buffer
+unsigned long panelDataBytes();
+
+// ---- EEPROM ----
+bool loadEeprom(const char* path);
+bool saveEeprom(const char* path);
+unsigned long eepromCellWrites(int addr);
+
+// ---- Motors (AF_DCMotor) and servos ----
+struct MotorState {
+  int speed;
+  int command;  // FORWARD/BACKWARD/BRAKE/RELEASE
+};
+MotorState motorState(int num);  // 1..4
+int servoMicrosOnPin(int pin);   // 0 when no attached servo
+
+}  // namespace sim
+
+#endif
@@ -0,0 +1,155 @@
+#include "Adafruit_SSD1306.h"
+
+#define WIRE_MAX BUFFER_LENGTH
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst_pin, uint32_t clkDuring,
+                                   uint32_t clkAfter)
+  : Adafruit_GFX(w, h), wire(twi ? twi : &Wire), buffer(nullptr), i2caddr(0), vccstate(0), wireClk(clkDuring),
+    restoreClk(clkAfter) {
+  (void)rst_pin;
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306(void) {
+  if (buffer) {
+    free(buffer);
+    buffer = nullptr;
+  }
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  wire->write(c);
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t* c, uint8_t n) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  uint16_t bytesOut = 1;
+  while (n--) {
+    if (bytesOut >= WIRE_MAX) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x00);
+      bytesOut = 1;
+    }
+    wire->write(pgm_read_byte(c++));
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  wire->setClock(wireClk);
+  ssd1306_command1(c);
+  wire->setClock(restoreClk);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin) {
+  (void)reset;
+  if (!buffer && !(buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8)))) return false;
+
+  clearDisplay();
+  vccstate = (int8_t)vcs;
+  i2caddr = (int8_t)(addr ? addr : ((HEIGHT == 32) ? 0x3C : 0x3D));
+  if (periphBegin) wire->begin();
+
+  wire->setClock(wireClk);
+  const uint8_t init[] = {
+    SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX, (uint8_t)(HEIGHT - 1),
+    SSD1306_SETDISPLAYOFFSET, 0x0, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP,
+    (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14), SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1,
+    SSD1306_COMSCANDEC, SSD1306_SETCOMPINS, 0x12, SSD1306_SETCONTRAST,
+    (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF), SSD1306_SETPRECHARGE,
+    (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1), SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME, SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON
+  };
+  ssd1306_commandList(init, sizeof(init));
+  wire->setClock(restoreClk);
+  return true;
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+  switch (getRotation()) {
+    case 1: {
+      int16_t t = x;
+      x = WIDTH - y - 1;
+      y = t;
+    } break;
+    case 2:
+      x = WIDTH - x - 1;
+      y = HEIGHT - y - 1;
+      break;
+    case 3: {
+      int16_t t = x;
+      x = y;
+      y = HEIGHT - t - 1;
+    } break;
+  }
+  switch (color) {
+    case SSD1306_WHITE: buffer[x + (y / 8) * WIDTH] |= (uint8_t)(1 << (y & 7)); break;
+    case SSD1306_BLACK: buffer[x + (y / 8) * WIDTH] &= (uint8_t)~(1 << (y & 7)); break;
+    case SSD1306_INVERSE: buffer[x + (y / 8) * WIDTH] ^= (uint8_t)(1 << (y & 7)); break;
+  }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
+
+void Adafruit_SSD1306::clearDisplay(void) {
+  memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return false;
+  return (buffer[x + (y / 8) * WIDTH] & (1 << (y & 7)));
+}
+
+uint8_t* Adafruit_SSD1306::getBuffer(void) {
+  return buffer;
+}
+
+void Adafruit_SSD1306::display(void) {
+  wire->setClock(wireClk);
+  static const uint8_t dlist1[] = { SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0 };
+  ssd1306_commandList(dlist1, sizeof(dlist1));
+  ssd1306_command1((uint8_t)(WIDTH - 1));
+
+  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+  uint8_t* ptr = buffer;
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x40);
+  uint16_t bytesOut = 1;
+  while (count--) {
+    if (bytesOut >= WIRE_MAX) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x40);
+      bytesOut = 1;
+    }
+    wire->write(*ptr++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+  wire->setClock(wireClk);
+  ssd1306_command1(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::dim(bool dim) {
+  wire->setClock(wireClk);
+  ssd1306_command1(SSD1306_SETCONTRAST);
+  ssd1306_command1(dim ? 0 : (vccstate == SSD1306_EXTERNALVCC ? 0x9F : 0xCF));
+  wire->setClock(restoreClk);
+}
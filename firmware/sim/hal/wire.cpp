@@ -0,0 +1,175 @@
+#include "Wire.h"
+#include "sim_hal.h"
+
+TwoWire Wire;
+
+// ================= SSD1306 panel =================
+// Decodes the command/data stream the way the controller does, so the simulator shows what the
+// real panel would show, including partial (windowed) updates.
+namespace {
+
+const int PANEL_W = 128;
+const int PANEL_PAGES = 8;
+
+struct Ssd1306Panel {
+  uint8_t ram[PANEL_W * PANEL_PAGES] = { 0 };
+  unsigned long dataBytes = 0;
+
+  uint8_t memMode = 2;  // power-on default: page addressing
+  uint8_t colStart = 0, colEnd = PANEL_W - 1;
+  uint8_t pageStart = 0, pageEnd = PANEL_PAGES - 1;
+  uint8_t col = 0, page = 0;
+
+  uint8_t pendingCmd = 0;
+  uint8_t argsLeft = 0;
+  uint8_t args[6];
+  uint8_t argPos = 0;
+
+  static uint8_t argCount(uint8_t c) {
+    switch (c) {
+      case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+      case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+      case 0x21: case 0x22: case 0xA3:
+        return 2;
+      case 0x29: case 0x2A:
+        return 5;
+      case 0x26: case 0x27:
+        return 6;
+      default:
+        return 0;
+    }
+  }
+
+  void applyCommand(uint8_t c) {
+    if (c == 0x20) {
+      memMode = args[0] & 0x03;
+    } else if (c == 0x21) {
+      colStart = args[0] & 0x7F;
+      colEnd = args[1] & 0x7F;
+      col = colStart;
+    } else if (c == 0x22) {
+      pageStart = args[0] & 0x07;
+      pageEnd = args[1] & 0x07;
+      page = pageStart;
+    } else if (c >= 0xB0 && c <= 0xB7) {
+      page = c & 0x07;
+    } else if (c <= 0x0F) {
+      col = (uint8_t)((col & 0xF0) | (c & 0x0F));
+    } else if (c >= 0x10 && c <= 0x1F) {
+      col = (uint8_t)((col & 0x0F) | ((c & 0x07) << 4));
+    }
+  }
+
+  void command(uint8_t c) {
+    if (argsLeft > 0) {
+      args[argPos++] = c;
+      if (--argsLeft == 0) applyCommand(pendingCmd);
+      return;
+    }
+    uint8_t n = argCount(c);
+    if (n > 0) {
+      pendingCmd = c;
+      argsLeft = n;
+      argPos = 0;
+      return;
+    }
+    applyCommand(c);
+  }
+
+  void data(uint8_t d) {
+    ram[(page % PANEL_PAGES) * PANEL_W + (col % PANEL_W)] = d;
+    dataBytes++;
+    if (memMode == 2) {
+      if (col < PANEL_W - 1) col++;
+      return;
+    }
+    if (col >= colEnd) {
+      col = colStart;
+      page = (page >= pageEnd) ? pageStart : (uint8_t)(page + 1);
+    } else {
+      col++;
+    }
+  }
+
+  // Each I2C transaction: control byte (Co=0) then either commands (0x00) or GDDRAM data (0x40).
+  void transaction(const uint8_t* buf, uint8_t len) {
+    if (len == 0) return;
+    bool isData = (buf[0] & 0x40) != 0;
+    for (uint8_t i = 1; i < len; i++) {
+      if (isData) data(buf[i]);
+      else command(buf[i]);
+    }
+  }
+} g_panel;
+
+}  // namespace
+
+namespace sim {
+
+const uint8_t* panelRam() {
+  return g_panel.ram;
+}
+
+unsigned long panelDataBytes() {
+  return g_panel.dataBytes;
+}
+
+}  // namespace sim
+
+// ================= TwoWire =================
+void TwoWire::begin() {
+  clock_ = 100000UL;
+}
+
+void TwoWire::setClock(uint32_t clock) {
+  if (clock > 0) clock_ = clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  address_ = address;
+  transmitting_ = true;
+  len_ = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (!transmitting_ || len_ >= BUFFER_LENGTH) return 0;
+  buf_[len_++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+  size_t n = 0;
+  while (n < quantity && write(data[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)sendStop;
+  if (!transmitting_) return 4;
+  transmitting_ = false;
+
+  // 9 clocks per byte (8 data + ACK) for the address and every payload byte.
+  uint64_t bits = 9ULL * (1ULL + len_);
+  uint64_t busUs = (bits * 1000000ULL + clock_ - 1) / clock_;
+  sim::syncCpu();
+  sim::advanceUs(busUs + sim::costs().i2cTransactionUs);
+
+  sim::Counters& c = sim::counters();
+  c.i2cTransactions++;
+  c.i2cBytes += len_;
+  c.i2cBusUs += busUs;
+
+  if (address_ == 0x3C || address_ == 0x3D) {
+    g_panel.transaction(buf_, len_);
+    return 0;
+  }
+  return 2;  // NACK on address
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+  (void)address;
+  (void)quantity;
+  (void)sendStop;
+  return 0;
+}
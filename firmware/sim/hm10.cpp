@@ -0,0 +1,106 @@
+#include "hm10.h"
+
+#include <Arduino.h>
+#include "sim_hal.h"
+
+namespace hm10 {
+namespace {
+
+const unsigned long RATES[] = { 9600, 19200, 38400, 57600, 115200 };  // AT+BAUD<n>
+const uint64_t COMMAND_GAP_US = 10000;  // the module ends a command on a pause in the stream
+const uint64_t REBOOT_US = 600000;
+
+unsigned long g_baud = 9600;
+unsigned long g_nextBaud = 9600;
+bool g_linked = false;
+uint64_t g_rebootUntilUs = 0;
+uint64_t g_lastByteUs = 0;
+std::string g_cmd;
+std::string g_name = "HMSoft";
+unsigned long g_atCommands = 0;
+unsigned long g_garbled = 0;
+
+bool rateMatches() {
+  return Serial1.baud() == g_baud && sim::nowUs() >= g_rebootUntilUs;
+}
+
+void reply(const std::string& s) {
+  Serial1.simInject((const uint8_t*)s.data(), s.size());
+}
+
+void runCommand() {
+  const std::string cmd = g_cmd;
+  g_cmd.clear();
+  if (cmd.compare(0, 2, "AT") != 0) return;  // wake string and other noise
+  g_atCommands++;
+  if (cmd == "AT") {
+    reply("OK");
+  } else if (cmd.compare(0, 7, "AT+BAUD") == 0 && cmd.size() == 8 && cmd[7] >= '0' && cmd[7] <= '4') {
+    g_nextBaud = RATES[cmd[7] - '0'];
+    reply("OK+Set:" + cmd.substr(7));
+  } else if (cmd.compare(0, 7, "AT+NAME") == 0 && cmd.size() > 7) {
+    g_name = cmd.substr(7);
+    reply("OK+Set:" + g_name);
+  } else if (cmd == "AT+RESET") {
+    reply("OK+RESET");
+    g_rebootUntilUs = sim::nowUs() + REBOOT_US;
+  } else {
+    reply("ERROR");
+  }
+}
+
+}  // namespace
+
+void begin(unsigned long baud) {
+  g_baud = g_nextBaud = baud;
+}
+
+void setLinked(bool linked) {
+  g_linked = linked;
+  g_cmd.clear();
+}
+
+void onTx(uint8_t c) {
+  if (!rateMatches()) {
+    g_garbled++;
+    return;
+  }
+  if (g_linked) return;  // goes to the phone
+  if (!g_cmd.empty() && sim::nowUs() - g_lastByteUs >= COMMAND_GAP_US) runCommand();
+  if (g_cmd.size() < 64) g_cmd.push_back((char)c);
+  g_lastByteUs = sim::nowUs();
+}
+
+void poll() {
+  if (g_rebootUntilUs && sim::nowUs() >= g_rebootUntilUs) {
+    g_rebootUntilUs = 0;
+    g_baud = g_nextBaud;
+  }
+  if (!g_cmd.empty() && sim::nowUs() - g_lastByteUs >= COMMAND_GAP_US) runCommand();
+}
+
+void deliver(const uint8_t* data, size_t len) {
+  if (!rateMatches()) {
+    g_garbled += len;
+    return;
+  }
+  Serial1.simInject(data, len);
+}
+
+unsigned long baud() {
+  return g_baud;
+}
+
+unsigned long atCommands() {
+  return g_atCommands;
+}
+
+unsigned long garbledBytes() {
+  return g_garbled;
+}
+
+const std::string& name() {
+  return g_name;
+}
+
+}  // namespace hm10
@@ -0,0 +1,28 @@
+#ifndef SIM_HM10_H
+#define SIM_HM10_H
+
+// HM-10 model on the far side of Serial1. While no phone is linked it answers the AT commands the
+// firmware uses (AT, AT+BAUD<n>, AT+NAME<name>, AT+RESET) with the module's unterminated replies;
+// AT+BAUD takes effect after AT+RESET and a reboot delay. Bytes only get through when Serial1 and
+// the module run at the same rate, so a wrong rate looks like silence, as on the bench.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+namespace hm10 {
+
+void begin(unsigned long baud);  // module rate at power-up (its stored AT+BAUD setting)
+void setLinked(bool linked);     // phone connected: AT commands are passed through as data
+void onTx(uint8_t c);            // byte written by the firmware to Serial1
+void poll();                     // once per loop pass: ends commands, finishes reboots
+void deliver(const uint8_t* data, size_t len);  // phone -> robot
+
+unsigned long baud();
+unsigned long atCommands();
+unsigned long garbledBytes();  // bytes lost to a rate mismatch or a reboot, both directions
+const std::string& name();
+
+}  // namespace hm10
+
+#endif
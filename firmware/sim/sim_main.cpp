@@ -0,0 +1,450 @@
+// Host-native driver for the ping-pong-robot firmware: runs the sketch's setup()/loop() against
+// the fake HAL in hal/ on a virtual clock, so a 5-minute drill replays in milliseconds.
+
+#include <Arduino.h>
+#include <AFMotor_R4.h>
+#include <EEPROM.h>
+
+#include "config.h"
+#include "display.h"
+#include "hm10.h"
+#include "jam.h"
+#include "logic.h"
+#include "motors.h"
+#include "servos.h"
+#include "sim_hal.h"
+#include "tach.h"
+#include "telemetry.h"
+#include "tx_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum EventKind { EV_BT, EV_BUTTON, EV_JOY, EV_BT_STATE, EV_JAM };
+
+struct Event {
+  uint64_t atUs;
+  EventKind kind;
+  std::string text;
+  int a;
+  int b;
+};
+
+struct Options {
+  uint64_t runMs = 10000;
+  uint32_t loopUs = 0;
+  uint32_t cpuScalePermille = 0;
+  unsigned long seed = 0;
+  unsigned long hm10Baud = 9600;
+  bool echoSerial = false;
+  bool echoBtTx = false;
+  bool dumpScreen = false;
+  bool traceServos = false;
+  bool traceFeeder = false;
+  bool traceShots = false;
+  double sagPct = 0;
+  bool stopWhenIdle = false;
+  const char* eepromPath = nullptr;
+  std::vector<Event> events;
+};
+
+void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --ms N            virtual run length in ms (default 10000)\n"
+          "  --bt T:LINE       send LINE (plus newline) to Serial1 at virtual ms T\n"
+          "  --bt-hex T:HEX    send raw bytes (hex pairs, e.g. a50103...) to Serial1 at ms T\n"
+          "  --press T[:DUR]   hold the joystick button from ms T for DUR ms (default 150)\n"
+          "  --joy T:X,Y       set raw joystick axes (0..1023) at ms T\n"
+          "  --bt-state T:L    drive the HM-10 STATE pin to level L at ms T (HIGH = phone linked)\n"
+          "  --jam T[:DUR]     no balls reach the feeder exit sensor from ms T, for DUR ms (default: until the end)\n"
+          "  --sag PCT         launcher supply falls linearly by PCT %% over the run (battery drain)\n"
+          "  --hm10-baud N     rate the HM-10 module is set to at power-up (default 9600)\n"
+          "  --stop-when-idle  end the run once a started drill stops\n"
+          "  --loop-us N       fixed CPU time charged per loop() pass\n"
+          "  --cpu-scale N     charge host CPU time x N/1000 to the virtual clock\n"
+          "  --seed N          randomSeed() before setup()\n"
+          "  --eeprom FILE     load EEPROM image before setup(), save it on exit\n"
+          "  --serial          echo Serial (debug) output\n"
+          "  --bt-tx           echo Serial1 output (robot -> app)\n"
+          "  --screen          print the final OLED frame\n"
+          "  --trace-servos    print 'ms pan_us tilt_us' whenever a servo pulse changes\n"
+          "  --trace-feeder    print 'ms phase balls' whenever the feeder phase changes\n"
+          "  --trace-shots     print 'ms rpm1 rpm2 rpm3' (model wheel speeds) as each ball leaves\n",
+          argv0);
+}
+
+bool splitTime(const char* arg, uint64_t& atMs, const char*& rest) {
+  char* end = nullptr;
+  unsigned long long t = strtoull(arg, &end, 10);
+  if (end == arg) return false;
+  atMs = t;
+  rest = (*end == ':') ? end + 1 : end;
+  return true;
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&](const char*& out) -> bool {
+      if (i + 1 >= argc) return false;
+      out = argv[++i];
+      return true;
+    };
+    const char* v = nullptr;
+    uint64_t t = 0;
+    const char* rest = nullptr;
+    if (a == "--ms") {
+      if (!next(v)) return false;
+      o.runMs = strtoull(v, nullptr, 10);
+    } else if (a == "--bt") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      o.events.push_back(Event{ t * 1000ULL, EV_BT, std::string(rest) + "\n", 0, 0 });
+    } else if (a == "--bt-hex") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      std::string bytes;
+      for (const char* h = rest; h[0] && h[1]; h += 2) {
+        char pair[3] = { h[0], h[1], '\0' };
+        char* end = nullptr;
+        long b = strtol(pair, &end, 16);
+        if (*end) return false;
+        bytes.push_back((char)b);
+      }
+      o.events.push_back(Event{ t * 1000ULL, EV_BT, bytes, 0, 0 });
+    } else if (a == "--press") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      int dur = *rest ? atoi(rest) : 150;
+      o.events.push_back(Event{ t * 1000ULL, EV_BUTTON, "", LOW, 0 });
+      o.events.push_back(Event{ (t + (uint64_t)dur) * 1000ULL, EV_BUTTON, "", HIGH, 0 });
+    } else if (a == "--joy") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      int x = 512, y = 512;
+      if (sscanf(rest, "%d,%d", &x, &y) != 2) return false;
+      o.events.push_back(Event{ t * 1000ULL, EV_JOY, "", x, y });
+    } else if (a == "--bt-state") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      o.events.push_back(Event{ t * 1000ULL, EV_BT_STATE, "", atoi(rest), 0 });
+    } else if (a == "--jam") {
+      if (!next(v) || !splitTime(v, t, rest)) return false;
+      o.events.push_back(Event{ t * 1000ULL, EV_JAM, "", 1, 0 });
+      if (*rest) o.events.push_back(Event{ (t + strtoull(rest, nullptr, 10)) * 1000ULL, EV_JAM, "", 0, 0 });
+    } else if (a == "--sag") {
+      if (!next(v)) return false;
+      o.sagPct = strtod(v, nullptr);
+    } else if (a == "--hm10-baud") {
+      if (!next(v)) return false;
+      o.hm10Baud = strtoul(v, nullptr, 10);
+    } else if (a == "--stop-when-idle") {
+      o.stopWhenIdle = true;
+    } else if (a == "--loop-us") {
+      if (!next(v)) return false;
+      o.loopUs = (uint32_t)strtoul(v, nullptr, 10);
+    } else if (a == "--cpu-scale") {
+      if (!next(v)) return false;
+      o.cpuScalePermille = (uint32_t)(strtod(v, nullptr) * 1000.0);
+    } else if (a == "--seed") {
+      if (!next(v)) return false;
+      o.seed = strtoul(v, nullptr, 10);
+    } else if (a == "--eeprom") {
+      if (!next(v)) return false;
+      o.eepromPath = v;
+    } else if (a == "--serial") {
+      o.echoSerial = true;
+    } else if (a == "--bt-tx") {
+      o.echoBtTx = true;
+    } else if (a == "--screen") {
+      o.dumpScreen = true;
+    } else if (a == "--trace-servos") {
+      o.traceServos = true;
+    } else if (a == "--trace-feeder") {
+      o.traceFeeder = true;
+    } else if (a == "--trace-shots") {
+      o.traceShots = true;
+    } else {
+      return false;
+    }
+  }
+  std::stable_sort(o.events.begin(), o.events.end(), [](const Event& x, const Event& y) { return x.atUs < y.atUs; });
+  return true;
+}
+
+bool g_echoSerial = false;
+bool g_echoBtTx = false;
+bool g_jammed = false;
+bool g_traceShots = false;
+
+// Launcher wheel model: each wheel follows its PWM with a first-order lag above a friction dead
+// band, scaled by the supply (--sag lowers it linearly over the run). Tach edges (one low pulse
+// per 1/TACH_PULSES_PER_REV turn) are scheduled ahead at the current speed so the pin-change ISR
+// sees them at their exact time; the lookahead covers the longest loop() pass.
+const double kWheelRpmAtFull = 6000.0;  // PWM 255 on a full supply
+const int kWheelDeadPwm = 15;
+const double kWheelTauUs = 150000.0;
+const uint64_t kTachLookaheadUs = 50000;
+const uint64_t kTachPulseUs = 100;
+const uint8_t kTachPins[3] = { TACH_PIN_1, TACH_PIN_2, TACH_PIN_3 };
+double g_sagPct = 0;
+uint64_t g_runUs = 1;
+double g_wheelRpm[3] = { 0, 0, 0 };
+
+void updateWheels() {
+  static uint64_t lastUs = 0;
+  static uint64_t scheduledToUs[3] = { 0, 0, 0 };  // edges are queued up to here
+  static double edgePhase[3] = { 0, 0, 0 };        // fraction of an edge period at scheduledToUs
+  const uint64_t now = sim::nowUs();
+  const double dtUs = (double)(now - lastUs);
+  lastUs = now;
+  const double supply = 1.0 - g_sagPct / 100.0 * std::min(1.0, (double)now / (double)g_runUs);
+  for (int i = 0; i < 3; i++) {
+    const sim::MotorState m = sim::motorState(i + 1);
+    const int pwm = (m.command == FORWARD || m.command == BACKWARD) ? m.speed : 0;
+    const double target =
+      pwm > kWheelDeadPwm ? (double)(pwm - kWheelDeadPwm) / (255 - kWheelDeadPwm) * kWheelRpmAtFull * supply : 0.0;
+    g_wheelRpm[i] += (target - g_wheelRpm[i]) * (1.0 - exp(-dtUs / kWheelTauUs));
+
+    if (scheduledToUs[i] < now) scheduledToUs[i] = now;
+    const uint64_t untilUs = now + kTachLookaheadUs;
+    const double edgesPerUs = g_wheelRpm[i] / 60e6 * TACH_PULSES_PER_REV;
+    while (scheduledToUs[i] < untilUs) {
+      const double toEdgeUs = edgesPerUs > 0 ? (1.0 - edgePhase[i]) / edgesPerUs : 1e18;
+      if ((double)scheduledToUs[i] + toEdgeUs > (double)untilUs) {
+        edgePhase[i] += (double)(untilUs - scheduledToUs[i]) * edgesPerUs;
+        scheduledToUs[i] = untilUs;
+        break;
+      }
+      scheduledToUs[i] += (uint64_t)toEdgeUs;
+      edgePhase[i] = 0;
+      sim::scheduleDigitalInput(kTachPins[i], LOW, scheduledToUs[i]);
+      sim::scheduleDigitalInput(kTachPins[i], HIGH, scheduledToUs[i] + kTachPulseUs);
+    }
+  }
+}
+
+// Ball-exit sensor model: while M4 pushes forward the disc turns at feederMsPerRotation(speed)
+// (the firmware's 7.5 V calibration) and a ball reaches the beam every 1/FEEDER_DISC_HOLES of a
+// turn, then blocks it for kBallBlockUs. Nothing comes out while jammed.
+const uint64_t kBallBlockUs = 40000;
+unsigned long g_ballsOut = 0;
+
+void updateBallSensor() {
+  static uint64_t lastUs = 0, blockedUntilUs = 0;
+  static double feedPhase = 0;  // fraction of the way to the next ball
+  const uint64_t now = sim::nowUs();
+  const sim::MotorState m4 = sim::motorState(4);
+  if (m4.command == FORWARD && m4.speed > 0 && !g_jammed) {
+    const double ballUs = (double)feederMsPerRotation(m4.speed) * 1000.0 / FEEDER_DISC_HOLES;
+    feedPhase += (double)(now - lastUs) / ballUs;
+  }
+  lastUs = now;
+  if (blockedUntilUs && now >= blockedUntilUs) {
+    sim::setDigitalInput(FEEDER_EXIT_PIN, HIGH);
+    blockedUntilUs = 0;
+  }
+  if (feedPhase >= 1.0 && !blockedUntilUs) {
+    feedPhase = 0;
+    g_ballsOut++;
+    if (g_traceShots) {
+      printf("shot %.3f %.0f %.0f %.0f\n", (double)now / 1000.0, g_wheelRpm[0], g_wheelRpm[1], g_wheelRpm[2]);
+    }
+    sim::setDigitalInput(FEEDER_EXIT_PIN, LOW);
+    blockedUntilUs = now + kBallBlockUs;
+  }
+}
+
+void serialSink(int port, uint8_t c) {
+  if (port == 1) hm10::onTx(c);
+  if (port == 0 && g_echoSerial) {
+    if (c != '\r') fputc(c, stdout);
+  } else if (port == 1 && g_echoBtTx) {
+    static bool lineStart = true;
+    if (lineStart) {
+      printf("[%8.3f BT TX] ", (double)sim::nowUs() / 1000.0);
+      lineStart = false;
+    }
+    if (c == '\n') lineStart = true;
+    if (c != '\r') fputc(c, stdout);
+  }
+}
+
+void applyEvent(const Event& e) {
+  switch (e.kind) {
+    case EV_BT:
+      hm10::deliver((const uint8_t*)e.text.data(), e.text.size());
+      break;
+    case EV_BUTTON:
+      sim::setDigitalInput(JOY_SW, e.a);
+      break;
+    case EV_JOY:
+      sim::setAnalogInput(JOY_X, e.a);
+      sim::setAnalogInput(JOY_Y, e.b);
+      break;
+    case EV_BT_STATE:
+      sim::setDigitalInput(BT_STATE_PIN, e.a);
+      hm10::setLinked(e.a == HIGH);
+      break;
+    case EV_JAM:
+      g_jammed = e.a != 0;
+      break;
+  }
+}
+
+const char* motorCmdName(int cmd) {
+  switch (cmd) {
+    case FORWARD: return "FWD";
+    case BACKWARD: return "REV";
+    case BRAKE: return "BRK";
+    default: return "OFF";
+  }
+}
+
+// Two pixel rows per text line using half-block characters.
+void dumpScreen() {
+  const uint8_t* ram = sim::panelRam();
+  printf("+--------------------------------------------------------------------------------------------------------------------------------+\n");
+  for (int y = 0; y < SCREEN_HEIGHT; y += 2) {
+    printf("|");
+    for (int x = 0; x < SCREEN_WIDTH; x++) {
+      bool top = ram[x + (y / 8) * SCREEN_WIDTH] & (1 << (y & 7));
+      bool bot = ram[x + ((y + 1) / 8) * SCREEN_WIDTH] & (1 << ((y + 1) & 7));
+      printf("%s", top ? (bot ? "█" : "▀") : (bot ? "▄" : " "));
+    }
+    printf("|\n");
+  }
+  printf("+--------------------------------------------------------------------------------------------------------------------------------+\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  g_echoSerial = opt.echoSerial;
+  g_echoBtTx = opt.echoBtTx;
+  g_traceShots = opt.traceShots;
+  g_sagPct = opt.sagPct;
+  g_runUs = opt.runMs * 1000ULL;
+  Serial.simSetTxSink(serialSink);
+  Serial1.simSetTxSink(serialSink);
+  hm10::begin(opt.hm10Baud);
+  if (opt.eepromPath) sim::loadEeprom(opt.eepromPath);
+  if (opt.seed) randomSeed(opt.seed);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  sim::setCpuScalePermille(opt.cpuScalePermille);
+
+  size_t nextEvent = 0;
+  auto pumpEvents = [&]() {
+    hm10::poll();
+    while (nextEvent < opt.events.size() && opt.events[nextEvent].atUs <= sim::nowUs()) {
+      applyEvent(opt.events[nextEvent++]);
+    }
+  };
+
+  pumpEvents();
+  setup();
+  const uint64_t setupUs = sim::nowUs();
+
+  const uint64_t endUs = opt.runMs * 1000ULL;
+  unsigned long passes = 0;
+  uint64_t maxPassUs = 0;
+  bool sawRunning = false;
+  while (sim::nowUs() < endUs) {
+    // Idle gaps between events are skipped only when the loop itself takes no virtual time.
+    pumpEvents();
+    uint64_t before = sim::nowUs();
+    loop();
+    sim::syncCpu();
+    updateBallSensor();
+    updateWheels();
+    sim::advanceUs(opt.loopUs);
+    if (sim::nowUs() == before) sim::advanceUs(1);
+    uint64_t passUs = sim::nowUs() - before;
+    if (passUs > maxPassUs) maxPassUs = passUs;
+    passes++;
+
+    if (opt.traceServos) {
+      static int lastPan = -1, lastTilt = -1;
+      int pan = sim::servoMicrosOnPin(SERVO_PAN_PIN), tilt = sim::servoMicrosOnPin(SERVO_TILT_PIN);
+      if (pan != lastPan || tilt != lastTilt) {
+        printf("servo %.3f %d %d\n", (double)sim::nowUs() / 1000.0, pan, tilt);
+        lastPan = pan;
+        lastTilt = tilt;
+      }
+    }
+
+    if (opt.traceFeeder) {
+      static const char* const kPhase[] = { "idle", "pullback", "on", "off", "unjam" };
+      static int lastPhase = -1;
+      if ((int)feederPhase != lastPhase) {
+        printf("feeder %.3f %s %d\n", (double)sim::nowUs() / 1000.0, kPhase[feederPhase], feederPulseCount);
+        lastPhase = (int)feederPhase;
+      }
+    }
+
+    if (isRunning) sawRunning = true;
+    if (opt.stopWhenIdle && sawRunning && !isRunning) break;
+  }
+
+  double wallMs =
+    (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wallStart).count() /
+    1000.0;
+  const uint64_t loopSpanUs = sim::nowUs() - setupUs;
+
+  if (opt.dumpScreen) dumpScreen();
+
+  const sim::Counters& c = sim::counters();
+  printf("virtual   : %.3f s (setup %.1f ms)  wall: %.1f ms\n", (double)sim::nowUs() / 1e6, (double)setupUs / 1000.0,
+         wallMs);
+  printf("loop      : %lu passes, avg %.2f ms, max %.2f ms\n", passes,
+         passes ? (double)loopSpanUs / (double)passes / 1000.0 : 0.0, (double)maxPassUs / 1000.0);
+  printf("i2c       : %lu transactions, %lu bytes, %.1f ms on the bus, %lu panel bytes\n", c.i2cTransactions, c.i2cBytes,
+         (double)c.i2cBusUs / 1000.0, sim::panelDataBytes());
+  printf("serial    : debug %lu B (stalled %.1f ms), bt tx %lu B (stalled %.1f ms), bt rx dropped %lu B\n",
+         Serial.simTxBytes(), (double)Serial.simTxStallUs() / 1000.0, Serial1.simTxBytes(),
+         (double)Serial1.simTxStallUs() / 1000.0, Serial1.simDroppedRx());
+  printf("tx queue  : dropped reply %lu stream %lu log %lu, %lu waited, %lu telemetry skipped\n", txDropped[TX_REPLY],
+         txDropped[TX_STREAM], txDropped[TX_LOG], txWaits, telemetrySkipped);
+  printf("hm10      : %lu baud (Serial1 %lu), name %s, %lu AT commands, %lu bytes garbled\n", hm10::baud(),
+         Serial1.baud(), hm10::name().c_str(), hm10::atCommands(), hm10::garbledBytes());
+  printf("io        : %lu analogRead, %lu servo writes, %lu motor run, %lu motor setSpeed, %lu eeprom writes\n",
+         c.analogReads, c.servoWrites, c.motorRuns, c.motorSetSpeeds, c.eepromWrites);
+  unsigned long wornWrites = 0;
+  int wornAddr = 0;
+  for (int addr = 0; addr < SIM_EEPROM_SIZE; addr++) {
+    if (sim::eepromCellWrites(addr) > wornWrites) {
+      wornWrites = sim::eepromCellWrites(addr);
+      wornAddr = addr;
+    }
+  }
+  printf("eeprom    : most-written cell %d, %lu writes\n", wornAddr, wornWrites);
+  printf("motors    :");
+  for (int m = 1; m <= 4; m++) {
+    sim::MotorState s = sim::motorState(m);
+    printf(" M%d %s %d", m, motorCmdName(s.command), s.command == RELEASE ? 0 : s.speed);
+  }
+  printf("\n");
+  printf("launcher  : wheels %.0f %.0f %.0f rpm, tach %u %u %u rpm\n", g_wheelRpm[0], g_wheelRpm[1], g_wheelRpm[2],
+         (unsigned)launcherRpm[0], (unsigned)launcherRpm[1], (unsigned)launcherRpm[2]);
+  printf("feeder    : %d pulses, %lu balls out, %u jams\n", feederPulseCount, g_ballsOut, (unsigned)jamCount);
+  printf("servos    : tilt %d us, pan %d us\n", sim::servoMicrosOnPin(SERVO_TILT_PIN), sim::servoMicrosOnPin(SERVO_PAN_PIN));
+  bool inSync = true;
+  for (uint8_t page = 0; page < SCREEN_HEIGHT / 8; page++) {
+    if (!displayPageShown(page, sim::panelRam() + page * SCREEN_WIDTH)) inSync = false;
+  }
+  printf("oled      : panel %s the last frame\n", inSync ? "matches" : "DIFFERS FROM");
+  printf("state     : screen %d, running %s, max played %lu ms\n", (int)currentScreen, isRunning ? "yes" : "no",
+         maxPlayedMs);
+
+  if (opt.eepromPath) sim::saveEeprom(opt.eepromPath);
+  return 0;
+}
@@ -1,6 +1,6 @@
 import SwiftUI
 
-private let feederModes = ["CONT", "P1/1", "P2/1", "P2/2", "CUSTOM"]
+private let feederModes = ["CONT", "P1/1", "P2/1", "P2/2", "CUSTOM", "BPM"]
 
 struct FeederPage: View {
   @ObservedObject var session = WatchSessionManager.shared
@@ -9,9 +9,11 @@ struct FeederPage: View {
   @State private var feederSpeed: Double = 200
   @State private var feederCustomOnMs: Double = 1500
   @State private var feederCustomOffMs: Double = 750
+  @State private var feederBpm: Double = 60
 
   private var feederMode: String { feederModes[feederModeIndex] }
   private var isCustom: Bool { feederMode == "CUSTOM" }
+  private var isBpm: Bool { feederMode == "BPM" }
 
   var body: some View {
     ScrollView(.vertical, showsIndicators: true) {
@@ -30,6 +32,10 @@ struct FeederPage: View {
             .padding(.bottom, 12)
           customOffSection
         }
+
+        if isBpm {
+          bpmSection
+        }
       }
       .frame(maxWidth: .infinity)
       .padding(.horizontal, 6)
@@ -94,6 +100,16 @@ struct FeederPage: View {
     }
   }
 
+  private var bpmSection: some View {
+    VStack(spacing: 4) {
+      Text("Balls/min \(Int(feederBpm))")
+        .font(.caption2)
+        .foregroundStyle(.secondary)
+      Slider(value: $feederBpm, in: 10...120, step: 5)
+        .onChange(of: feederBpm) { _, v in send("feederBpm", String(Int(v))) }
+    }
+  }
+
   private func formatMs(_ ms: Double) -> String {
     if ms >= 1000 {
       return String(format: "%.1fs", ms / 1000)
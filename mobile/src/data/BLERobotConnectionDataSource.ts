@@ -2,7 +2,7 @@ import { Platform } from 'react-native';
 import { BleManager, Device } from 'react-native-ble-plx';
 import { getDeviceName } from 'react-native-device-info';
 import type { RobotConfig } from './RobotConfig';
-import type { RobotConnectionDataSource, ConnectionState } from './RobotConnectionDataSource';
+import type { RobotConnectionDataSource, ConnectionState, RobotTelemetry } from './RobotConnectionDataSource';
 import {
   configToConfigLine,
   getLiveAimLine,
@@ -10,13 +10,37 @@ import {
   getStopCommand,
   getDeviceNameCommand,
   getDisconnectCommand,
+  getProtocolQueryCommand,
+  parseProtocolVersionLine,
+  configToConfigFrame,
+  getLiveAimFrame,
+  getLiveAimSampleFrame,
+  parseRobotFrame,
+  parseTelemetryFrame,
+  BT_FRAME_SYNC_CHAR,
+  BT_FRAME_VERSION,
+  configToFields,
+  diffConfigFields,
+  configDeltaLine,
+  configDeltaFrame,
+  parseConfigRevision,
+  CONFIG_DELTA_MAX_FIELDS,
+  drillStepLine,
+  drillStepFrame,
+  getDrillClearCommand,
+  getDrillClearFrame,
+  DRILL_MAX_STEPS,
+  DRILL_MAX_FIELDS,
 } from './btProtocol';
+import type { DrillStep } from './btProtocol';
 
 const HM10_SERVICE_UUID = '0000ffe0-0000-1000-8000-00805f9b34fb';
 const HM10_CHAR_UUID = '0000ffe1-0000-1000-8000-00805f9b34fb';
 const CHUNK_SIZE = 20;
 const CHUNK_DELAY_MS = 35;
 const ACK_TIMEOUT_MS = 2500;
+const AIM_STREAM_INTERVAL_MS = 25; // 40 Hz
+const AIM_STREAM_IDLE_TICKS = 8; // timer stops after 200 ms without a new target
 
 function toBase64(str: string): string {
   const key = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
@@ -128,6 +152,7 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
   private state: ConnectionState = { status: 'disconnected' };
   private listeners = new Set<(s: ConnectionState) => void>();
   private liveAimListeners = new Set<(pan: number, tilt: number) => void>();
+  private telemetryListeners = new Set<(telemetry: RobotTelemetry) => void>();
   private deviceId: string | null = null;
   private deviceDisplayName: string | null = null;
   private disconnectionSubscription: { remove: () => void } | null = null;
@@ -135,6 +160,23 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
   private rxBuffer = '';
   private pendingConfigAck: PendingAck | null = null;
   private pendingStartAck: PendingAck | null = null;
+  private pendingDrillAck: PendingAck | null = null;
+  /** Binary frame version the robot accepts (0 = text only, until it answers V). */
+  private frameVersion = 0;
+  /** Config fields the robot last acknowledged; deltas are diffed against these (null = send a full config). */
+  private ackedFields: number[] | null = null;
+  /** Robot config revision of ackedFields; the robot also bumps it for changes made on its side. */
+  private ackedRevision: number | null = null;
+  /** Fields of the config update waiting for its OK,C / OK,U. */
+  private inFlightFields: number[] | null = null;
+  private inFlightTimeout: ReturnType<typeof setTimeout> | null = null;
+  /** Newest config requested while an update was in flight; older ones are dropped. */
+  private queuedConfig: RobotConfig | null = null;
+  private aimTarget: { pan: number; tilt: number } | null = null;
+  private aimSent: { pan: number; tilt: number } | null = null;
+  private aimTimer: ReturnType<typeof setInterval> | null = null;
+  private aimIdleTicks = 0;
+  private aimWriting = false;
 
   private setState(next: Partial<ConnectionState>) {
     this.state = { ...this.state, ...next };
@@ -157,10 +199,16 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
     clearTimeout(pending.timeoutId);
     this.pendingConfigAck = this.pendingConfigAck === pending ? null : this.pendingConfigAck;
     this.pendingStartAck = this.pendingStartAck === pending ? null : this.pendingStartAck;
+    this.pendingDrillAck = this.pendingDrillAck === pending ? null : this.pendingDrillAck;
   }
 
   private onAckLine(line: string): void {
     const t = line.trim();
+    const version = parseProtocolVersionLine(t);
+    if (version != null) {
+      this.frameVersion = version;
+      return;
+    }
     if (t.startsWith('A,')) {
       const parts = t.slice(2).split(',');
       const pan = parts.length >= 1 ? parseInt(parts[0], 10) / 1000 : 0;
@@ -170,6 +218,9 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
       }
       return;
     }
+    if (t.startsWith('OK,C') || t.startsWith('OK,U')) {
+      this.onConfigAck(parseConfigRevision(t), t.startsWith('OK,C'));
+    }
     if (t.startsWith('OK,C')) {
       const p = this.pendingConfigAck;
       this.pendingConfigAck = null;
@@ -188,7 +239,19 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
       }
       return;
     }
+    // Drill replies answer uploadDrill only; an ERR,Q must not fail a config update
+    if (t.startsWith('OK,Q') || t.startsWith('ERR,Q')) {
+      const p = this.pendingDrillAck;
+      this.pendingDrillAck = null;
+      if (p) {
+        clearTimeout(p.timeoutId);
+        if (t.startsWith('OK,Q')) p.resolve();
+        else p.reject(new Error(`Robot error: ${t}`));
+      }
+      return;
+    }
     if (t.startsWith('ERR,')) {
+      if (this.inFlightFields) this.onConfigRejected();
       const err = new Error(`Robot error: ${t}`);
       if (this.pendingConfigAck) {
         const p = this.pendingConfigAck;
@@ -205,18 +268,80 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
     }
   }
 
-  private processAckBuffer(): void {
-    let idx: number;
-    while ((idx = this.rxBuffer.indexOf('\n')) >= 0) {
-      const line = this.rxBuffer.slice(0, idx);
-      this.rxBuffer = this.rxBuffer.slice(idx + 1);
-      this.onAckLine(line);
+  private onConfigAck(revision: number | null, full: boolean): void {
+    // OK,C / OK,U carry the robot's config revision; firmware without one predates deltas, so keep
+    // sending full configs to it. A delta only holds on top of the baseline if nothing else changed
+    // the config in between, i.e. the robot moved exactly one revision.
+    const inOrder = full || (this.ackedRevision != null && revision === ((this.ackedRevision + 1) & 0xffff));
+    if (revision != null && inOrder) {
+      this.ackedFields = this.inFlightFields;
+      this.ackedRevision = revision;
+    } else {
+      this.dropConfigBaseline();
     }
-    const cr = this.rxBuffer.indexOf('\r');
-    if (cr >= 0) {
-      const line = this.rxBuffer.slice(0, cr);
-      this.rxBuffer = this.rxBuffer.slice(cr + 1);
-      this.onAckLine(line);
+    this.finishInFlight();
+  }
+
+  private onConfigRejected(): void {
+    this.dropConfigBaseline();
+    this.finishInFlight();
+  }
+
+  /** Telemetry with a newer revision than the acked one: the config was changed on the robot. */
+  private onTelemetryRevision(revision: number | null): void {
+    if (revision == null || this.inFlightFields || this.ackedRevision == null) return;
+    // A frame queued before the ack can still arrive after it (replies overtake telemetry); those
+    // are behind the acked revision and say nothing.
+    const ahead = (revision - this.ackedRevision) & 0xffff;
+    if (ahead !== 0 && ahead < 0x8000) this.dropConfigBaseline();
+  }
+
+  private dropConfigBaseline(): void {
+    this.ackedFields = null;
+    this.ackedRevision = null;
+  }
+
+  private finishInFlight(): void {
+    if (this.inFlightTimeout) clearTimeout(this.inFlightTimeout);
+    this.inFlightTimeout = null;
+    this.inFlightFields = null;
+    const next = this.queuedConfig;
+    this.queuedConfig = null;
+    if (next) this.sendConfig(next).catch(() => {});
+  }
+
+  private resetConfigSync(): void {
+    if (this.inFlightTimeout) clearTimeout(this.inFlightTimeout);
+    this.inFlightTimeout = null;
+    this.inFlightFields = null;
+    this.queuedConfig = null;
+    this.dropConfigBaseline();
+  }
+
+  /** Splits the notification stream into text lines and binary frames (SYNC never occurs in text). */
+  private processAckBuffer(): void {
+    for (;;) {
+      const sync = this.rxBuffer.indexOf(BT_FRAME_SYNC_CHAR);
+      const nl = this.rxBuffer.search(/[\r\n]/);
+      if (sync >= 0 && (nl < 0 || sync < nl)) {
+        const frame = parseRobotFrame(this.rxBuffer, sync);
+        if (frame === 'incomplete') return;
+        if (frame == null) {
+          this.rxBuffer = this.rxBuffer.slice(sync + 1);
+          continue;
+        }
+        this.rxBuffer = this.rxBuffer.slice(sync + frame.length);
+        const telemetry = parseTelemetryFrame(frame);
+        if (telemetry) {
+          this.onTelemetryRevision(telemetry.configRevision);
+          this.telemetryListeners.forEach((fn) => fn(telemetry));
+        }
+        continue;
+      }
+      if (nl < 0) return;
+      const line = this.rxBuffer.slice(0, nl);
+      this.rxBuffer = this.rxBuffer.slice(nl + 1);
+      if (line.length > 0) this.onAckLine(line);
     }
   }
 
@@ -236,6 +361,8 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
 
   private onBleDisconnected(): void {
     this.clearConnectionListeners();
+    this.resetConfigSync();
+    this.stopAimStream();
     this.deviceId = null;
     this.deviceDisplayName = null;
     this.setState({ status: 'disconnected', error: undefined, deviceName: null });
@@ -267,6 +394,9 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
       this.deviceId = device.id;
       this.deviceDisplayName = device.name || 'HM-10';
       this.rxBuffer = '';
+      this.frameVersion = 0;
+      this.resetConfigSync();
+      this.stopAimStream();
       this.startNotificationMonitor(device.id);
       this.setState({
         status: 'connected',
@@ -283,6 +413,7 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
         nameToSend = Platform.OS === 'ios' ? 'iPhone' : Platform.OS === 'android' ? 'Android' : 'Phone';
       }
       await this.writeLine(getDeviceNameCommand(nameToSend.trim()));
+      await this.writeLine(getProtocolQueryCommand());
       this.subscribeDisconnect(deviceObj);
     } catch (e) {
       this.clearConnectionListeners();
@@ -339,8 +470,43 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
     }
   }
 
+  private useFrames(): boolean {
+    return this.frameVersion >= BT_FRAME_VERSION;
+  }
+
+  private configPayload(config: RobotConfig): string {
+    return this.useFrames() ? configToConfigFrame(config) : configToConfigLine(config);
+  }
+
+  /** Config fields sent and awaiting an ack; a lost ack falls back to a full config next time. */
+  private trackInFlight(fields: number[]): void {
+    if (this.inFlightTimeout) clearTimeout(this.inFlightTimeout);
+    this.inFlightFields = fields;
+    this.inFlightTimeout = setTimeout(() => {
+      this.inFlightTimeout = null;
+      this.onConfigRejected();
+    }, ACK_TIMEOUT_MS);
+  }
+
+  /**
+   * Sends only the fields that changed since the robot's last ack (U line / delta frame). One update
+   * is in flight at a time; configs arriving meanwhile are coalesced and the newest goes out on the ack.
+   */
   async sendConfig(config: RobotConfig): Promise<void> {
-    await this.writeLine(configToConfigLine(config));
+    if (this.inFlightFields) {
+      this.queuedConfig = config;
+      return;
+    }
+    const fields = configToFields(config);
+    const base = this.ackedFields;
+    const delta = base ? diffConfigFields(base, fields) : null;
+    if (delta && delta.length === 0) return;
+    this.trackInFlight(fields);
+    if (delta && delta.length <= CONFIG_DELTA_MAX_FIELDS) {
+      await this.writeLine(this.useFrames() ? configDeltaFrame(delta) : configDeltaLine(delta));
+    } else {
+      await this.writeLine(this.configPayload(config));
+    }
   }
 
   async sendConfigAndWaitAck(config: RobotConfig, timeoutMs: number = ACK_TIMEOUT_MS): Promise<void> {
@@ -348,7 +514,9 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
       throw new Error('Not connected');
     }
     this.clearPendingAck(this.pendingConfigAck);
-    await this.writeLine(configToConfigLine(config));
+    this.queuedConfig = null;
+    this.trackInFlight(configToFields(config));
+    await this.writeLine(this.configPayload(config));
     return new Promise<void>((resolve, reject) => {
       const timeoutId = setTimeout(() => {
         if (this.pendingConfigAck === pending) {
@@ -380,7 +548,83 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
   }
 
   async sendLiveAim(pan: number, tilt: number): Promise<void> {
-    await this.writeLine(getLiveAimLine(pan, tilt));
+    await this.writeLine(this.useFrames() ? getLiveAimFrame(pan, tilt) : getLiveAimLine(pan, tilt));
+  }
+
+  streamLiveAim(pan: number, tilt: number): void {
+    this.aimTarget = { pan, tilt };
+    if (this.aimTimer != null) return;
+    this.aimIdleTicks = 0;
+    this.aimTimer = setInterval(() => this.aimStreamTick(), AIM_STREAM_INTERVAL_MS);
+    this.aimStreamTick();
+  }
+
+  /** Sends the newest target once per interval; targets set in between are dropped, never queued. */
+  private aimStreamTick(): void {
+    const t = this.aimTarget;
+    const unchanged = !t || (this.aimSent != null && this.aimSent.pan === t.pan && this.aimSent.tilt === t.tilt);
+    if (unchanged) {
+      if (++this.aimIdleTicks >= AIM_STREAM_IDLE_TICKS) this.stopAimStream();
+      return;
+    }
+    if (this.aimWriting) return;
+    this.aimIdleTicks = 0;
+    this.aimSent = t;
+    this.aimWriting = true;
+    // Firmware with frame version 2 buffers timestamped samples; older firmware gets plain aims.
+    const payload = this.useFrames()
+      ? getLiveAimSampleFrame(t.pan, t.tilt, Date.now())
+      : getLiveAimLine(t.pan, t.tilt);
+    this.writeLine(payload)
+      .catch(() => {})
+      .finally(() => {
+        this.aimWriting = false;
+      });
+  }
+
+  private stopAimStream(): void {
+    if (this.aimTimer != null) clearInterval(this.aimTimer);
+    this.aimTimer = null;
+    this.aimTarget = null;
+    this.aimSent = null;
+    this.aimWriting = false;
+  }
+
+  /** Clears the robot's drill program, then sends the steps in order, each waiting for its OK,Q. */
+  async uploadDrill(steps: DrillStep[], timeoutMs: number = ACK_TIMEOUT_MS): Promise<void> {
+    if (!this.deviceId || this.state.status !== 'connected') {
+      throw new Error('Not connected');
+    }
+    if (steps.length > DRILL_MAX_STEPS || steps.some((st) => st.fields.length > DRILL_MAX_FIELDS)) {
+      throw new Error('Drill too large');
+    }
+    const frames = this.useFrames();
+    await this.sendDrillAndWaitAck(frames ? getDrillClearFrame() : getDrillClearCommand(), timeoutMs);
+    for (let i = 0; i < steps.length; i++) {
+      const payload = frames ? drillStepFrame(i + 1, steps[i]) : drillStepLine(i + 1, steps[i]);
+      await this.sendDrillAndWaitAck(payload, timeoutMs);
+    }
+  }
+
+  private async sendDrillAndWaitAck(payload: string, timeoutMs: number): Promise<void> {
+    this.clearPendingAck(this.pendingDrillAck);
+    const ack = new Promise<void>((resolve, reject) => {
+      const timeoutId = setTimeout(() => {
+        if (this.pendingDrillAck === pending) {
+          this.pendingDrillAck = null;
+          reject(new Error('Drill ACK timeout'));
+        }
+      }, timeoutMs);
+      const pending: PendingAck = { resolve, reject, timeoutId };
+      this.pendingDrillAck = pending;
+    });
+    try {
+      await this.writeLine(payload);
+    } catch (e) {
+      this.clearPendingAck(this.pendingDrillAck);
+      throw e;
+    }
+    return ack;
   }
 
   async start(): Promise<void> {
@@ -405,4 +649,9 @@ export class BLERobotConnectionDataSource implements RobotConnectionDataSource {
     this.liveAimListeners.add(listener);
     return () => this.liveAimListeners.delete(listener);
   }
+
+  subscribeTelemetry(listener: (telemetry: RobotTelemetry) => void): () => void {
+    this.telemetryListeners.add(listener);
+    return () => this.telemetryListeners.delete(listener);
+  }
 }
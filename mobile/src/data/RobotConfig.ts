@@ -1,3 +1,5 @@
+import { secondsPerRotation, HOLES_PER_ROTATION } from './feederCalibration';
+
 export type AxisMode = 'LIVE' | 'AUTO1' | 'AUTO2' | 'RANDOM';
 
 export type SpinDirection =
@@ -11,7 +13,7 @@ export type SpinDirection =
   | 'W'
   | 'NW';
 
-export type FeederMode = 'CONT' | 'P1/1' | 'P2/1' | 'P2/2' | 'CUSTOM';
+export type FeederMode = 'CONT' | 'P1/1' | 'P2/1' | 'P2/2' | 'CUSTOM' | 'BPM';
 
 export type RobotConfig = {
   panMode: AxisMode;
@@ -41,8 +43,12 @@ export type RobotConfig = {
   feederSpeed: number;
   feederCustomOnMs: number;
   feederCustomOffMs: number;
+  /** Balls per minute in BPM mode (10–120). */
+  feederBpm: number;
   timerIndex: number;
   timerSoundAlert: boolean;
+  /** Stop after this many balls; 0 = no limit. */
+  ballLimit: number;
 };
 
 export const DEFAULT_CONFIG: RobotConfig = {
@@ -73,8 +79,10 @@ export const DEFAULT_CONFIG: RobotConfig = {
   feederSpeed: 200,
   feederCustomOnMs: 1500,
   feederCustomOffMs: 750,
+  feederBpm: 60,
   timerIndex: 0,
   timerSoundAlert: false,
+  ballLimit: 0,
 };
 
 export const AXIS_MODES: AxisMode[] = ['LIVE', 'AUTO1', 'AUTO2', 'RANDOM'];
@@ -89,23 +97,35 @@ export const SPIN_DIRECTIONS: SpinDirection[] = [
   'W',
   'NW',
 ];
-export const FEEDER_MODES: FeederMode[] = ['CONT', 'P1/1', 'P2/1', 'P2/2', 'CUSTOM'];
+export const FEEDER_MODES: FeederMode[] = ['CONT', 'P1/1', 'P2/1', 'P2/2', 'CUSTOM', 'BPM'];
 
-/** Tempos on/off (ms) por modo; CUSTOM usa customOnMs/customOffMs. */
+/**
+ * Tempos on/off (ms) por modo; CUSTOM usa customOnMs/customOffMs. BPM turns the disc one hole
+ * per 60000/bpm ms at the calibrated speed, same as the firmware's feederPulseTiming().
+ */
 export function getFeederOnOffMs(
   mode: FeederMode,
   customOnMs: number,
-  customOffMs: number
+  customOffMs: number,
+  bpm: number = DEFAULT_CONFIG.feederBpm,
+  speed: number = DEFAULT_CONFIG.feederSpeed
 ): { onMs: number; offMs: number } {
   switch (mode) {
     case 'P1/1': return { onMs: 1000, offMs: 1000 };
     case 'P2/1': return { onMs: 2000, offMs: 1000 };
     case 'P2/2': return { onMs: 2000, offMs: 2000 };
     case 'CUSTOM': return { onMs: customOnMs, offMs: customOffMs };
+    case 'BPM': {
+      const cycleMs = Math.round(60000 / Math.max(1, bpm));
+      const onMs = Math.round((secondsPerRotation(speed) * 1000) / HOLES_PER_ROTATION);
+      return { onMs, offMs: Math.max(0, cycleMs - onMs) };
+    }
     default: return { onMs: 0, offMs: 0 };
   }
 }
 export const TIMER_OPTIONS = ['OFF', '15s', '30s', '1m', '2m', '5m'] as const;
+/** Ball-count stop options (0 = OFF); the robot accepts any value up to 999. */
+export const BALL_LIMIT_OPTIONS = [0, 10, 25, 50, 100, 200] as const;
 
 export function spinDirectionToAngleDeg(dir: SpinDirection): number {
   const map: Record<SpinDirection, number> = {
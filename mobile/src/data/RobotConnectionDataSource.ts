@@ -1,4 +1,5 @@
 import type { RobotConfig } from './RobotConfig';
+import type { DrillStep } from './btProtocol';
 
 /**
  * Data source for robot communication. Implement BluetoothRobotConnectionDataSource
@@ -12,6 +13,28 @@ export type ConnectionState = {
   deviceName?: string | null;
 };
 
+/** Live robot state from the periodic telemetry frame (firmware telemetry.h), ~5 Hz. */
+export type RobotTelemetry = {
+  seq: number;
+  running: boolean;
+  aimStreaming: boolean;
+  pan: number;
+  tilt: number;
+  launcherSpeeds: [number, number, number];
+  feederPhase: 'IDLE' | 'PULLBACK' | 'ON' | 'OFF' | 'UNJAM';
+  loopP50Us: number;
+  loopMaxUs: number;
+  controlOverruns: number;
+  elapsedMs: number;
+  shots: number;
+  /** Feeder jams detected this run; 0 from firmware without jam detection. */
+  jams: number;
+  /** Measured launcher wheel speeds (RPM); zeros from firmware without wheel tachs. */
+  wheelRpm: [number, number, number];
+  /** Robot config revision (as in OK,C / OK,U), including robot-side changes; null from older firmware. */
+  configRevision: number | null;
+};
+
 export interface RobotConnectionDataSource {
   connect(): Promise<void>;
   disconnect(): Promise<void>;
@@ -19,11 +42,16 @@ export interface RobotConnectionDataSource {
   sendConfigAndWaitAck(config: RobotConfig, timeoutMs?: number): Promise<void>;
   startAndWaitAck(timeoutMs?: number): Promise<void>;
   sendLiveAim(pan: number, tilt: number): Promise<void>;
+  /** Latest aim while the user drags; sent as timestamped samples at a fixed rate. */
+  streamLiveAim(pan: number, tilt: number): void;
+  /** Replaces the robot's drill program (firmware drill.h); runs on every start sent by the app (not on starts from the robot's menu). Rejects while a run is active. */
+  uploadDrill(steps: DrillStep[], timeoutMs?: number): Promise<void>;
   start(): Promise<void>;
   stop(): Promise<void>;
   getConnectionState(): ConnectionState;
   subscribeConnectionState(listener: (state: ConnectionState) => void): () => void;
   subscribeLiveAimFromRobot(listener: (pan: number, tilt: number) => void): () => void;
+  subscribeTelemetry(listener: (telemetry: RobotTelemetry) => void): () => void;
 }
 
 export class StubRobotConnectionDataSource implements RobotConnectionDataSource {
@@ -56,6 +84,12 @@ export class StubRobotConnectionDataSource implements RobotConnectionDataSource
     await Promise.resolve();
   }
 
+  streamLiveAim(_pan: number, _tilt: number): void {}
+
+  async uploadDrill(_steps: DrillStep[], _timeoutMs?: number): Promise<void> {
+    await Promise.resolve();
+  }
+
   async start(): Promise<void> {
     await Promise.resolve();
   }
@@ -78,6 +112,10 @@ export class StubRobotConnectionDataSource implements RobotConnectionDataSource
     return () => {};
   }
 
+  subscribeTelemetry(_listener: (telemetry: RobotTelemetry) => void): () => void {
+    return () => {};
+  }
+
   private setState(next: Partial<ConnectionState>) {
     this.state = { ...this.state, ...next };
     this.listeners.forEach((fn) => fn(this.getConnectionState()));
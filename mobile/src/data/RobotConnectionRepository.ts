@@ -1,6 +1,7 @@
 import type { RobotConfig } from './RobotConfig';
-import type { RobotConnectionDataSource } from './RobotConnectionDataSource';
+import type { RobotConnectionDataSource, RobotTelemetry } from './RobotConnectionDataSource';
 import { BLERobotConnectionDataSource } from './BLERobotConnectionDataSource';
+import type { DrillStep } from './btProtocol';
 
 export type RunState = {
   runStartTime: number | null;
@@ -40,6 +41,14 @@ function createRepository(dataSource: RobotConnectionDataSource) {
       await dataSource.sendLiveAim(pan, tilt);
     },
 
+    streamLiveAim(pan: number, tilt: number): void {
+      dataSource.streamLiveAim(pan, tilt);
+    },
+
+    async uploadDrill(steps: DrillStep[]): Promise<void> {
+      await dataSource.uploadDrill(steps);
+    },
+
     async startRun(config: RobotConfig): Promise<void> {
       const maxAttempts = 3;
       const retryDelayAfterRejectMs = 350;
@@ -98,6 +107,10 @@ function createRepository(dataSource: RobotConnectionDataSource) {
       return dataSource.subscribeLiveAimFromRobot(listener);
     },
 
+    subscribeTelemetry(listener: (telemetry: RobotTelemetry) => void): () => void {
+      return dataSource.subscribeTelemetry(listener);
+    },
+
     getDataSource(): RobotConnectionDataSource {
       return dataSource;
     },
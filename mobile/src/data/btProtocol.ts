@@ -1,7 +1,8 @@
 import type { RobotConfig, AxisMode, FeederMode, SpinDirection } from './RobotConfig';
+import type { RobotTelemetry } from './RobotConnectionDataSource';
 
 const AXIS_MODE_ORDER: AxisMode[] = ['LIVE', 'AUTO1', 'AUTO2', 'RANDOM'];
-const FEEDER_MODE_ORDER: FeederMode[] = ['CONT', 'P1/1', 'P2/1', 'P2/2', 'CUSTOM'];
+const FEEDER_MODE_ORDER: FeederMode[] = ['CONT', 'P1/1', 'P2/1', 'P2/2', 'CUSTOM', 'BPM'];
 const SPIN_ORDER: SpinDirection[] = ['NONE', 'N', 'NE', 'E', 'SE', 'S', 'SW', 'W', 'NW'];
 
 function axisModeToInt(m: AxisMode): number {
@@ -20,9 +21,9 @@ function spinDirectionToInt(d: SpinDirection): number {
 const CONFIG_START = '<C,';
 const CONFIG_END = '>';
 
-/** Config line with framing: <C,v0,v1,...,v25>\n so robot only runs when a complete block (start+end) is received. */
-export function configToConfigLine(config: RobotConfig): string {
-  const a = [
+/** The 28 config values in wire order (shared by the text line, the binary frame and deltas). */
+export function configToFields(config: RobotConfig): number[] {
+  return [
     axisModeToInt(config.panMode),
     axisModeToInt(config.tiltMode),
     Math.round(config.panTarget * 1000),
@@ -49,8 +50,40 @@ export function configToConfigLine(config: RobotConfig): string {
     config.feederCustomOnMs,
     config.feederCustomOffMs,
     config.timerIndex,
+    config.feederBpm,
+    config.ballLimit,
   ];
-  return CONFIG_START + a.join(',') + CONFIG_END + '\n';
+}
+
+/** Config line with framing: <C,v0,v1,...,v27>\n so robot only runs when a complete block (start+end) is received. */
+export function configToConfigLine(config: RobotConfig): string {
+  return CONFIG_START + configToFields(config).join(',') + CONFIG_END + '\n';
+}
+
+/** Changed fields as [fieldId, value] pairs; fieldId is the index in the <C,...> order. */
+export type ConfigDelta = Array<[number, number]>;
+
+/** Most fields one U line may carry (kept at 13 so firmware that holds 26 ints per line accepts it). */
+export const CONFIG_DELTA_MAX_FIELDS = 13;
+
+export function diffConfigFields(prev: number[], next: number[]): ConfigDelta {
+  const delta: ConfigDelta = [];
+  next.forEach((v, i) => {
+    if (prev[i] !== v) delta.push([i, v]);
+  });
+  return delta;
+}
+
+/** Delta line: U,<id>,<value>[,<id>,<value>...]\n. Robot applies only those fields and replies OK,U,<revision>. */
+export function configDeltaLine(delta: ConfigDelta): string {
+  return 'U,' + delta.map(([id, v]) => `${id},${v}`).join(',') + '\n';
+}
+
+/** Revision from OK,C,<rev> / OK,U,<rev>; null for other lines or firmware that does not send one. */
+export function parseConfigRevision(line: string): number | null {
+  if (!line.startsWith('OK,C,') && !line.startsWith('OK,U,')) return null;
+  const v = parseInt(line.slice(5), 10);
+  return Number.isNaN(v) ? null : v;
 }
 
 /** Error codes from robot: ERR,C,INCOMPLETE = block truncated; ERR,C,INVALID = wrong field count. App retries on any ERR,C. */
@@ -79,3 +112,207 @@ export function getLiveAimLine(pan: number, tilt: number): string {
   return `A,${Math.round(pan * 1000)},${Math.round(tilt * 1000)}\n`;
 }
 
+
+/** Asks the robot which binary frame version it accepts; reply is OK,V,<version>. Older firmware does not answer. */
+export function getProtocolQueryCommand(): string {
+  return 'V\n';
+}
+
+/** Version from an OK,V,<n> line, or null. */
+export function parseProtocolVersionLine(line: string): number | null {
+  if (!line.startsWith('OK,V,')) return null;
+  const v = parseInt(line.slice(5), 10);
+  return Number.isNaN(v) ? null : v;
+}
+
+// ---- Binary frames (firmware bt_frame.h): SYNC VER TYPE LEN payload CRC16, little-endian ----
+// Strings below hold one byte per char (0..255), which is what the BLE writer base64-encodes.
+
+/**
+ * 2 = aim frames may carry a timestamp (streamed aim), 3 = drill frames, 4 = 28 config fields
+ * (feederBpm, ballLimit). The robot still accepts older frames.
+ */
+export const BT_FRAME_VERSION = 4;
+const BT_FRAME_SYNC = 0xa5;
+const FRAME_CONFIG = 0x01;
+const FRAME_AIM = 0x02;
+const FRAME_START = 0x03;
+const FRAME_STOP = 0x04;
+const FRAME_DELTA = 0x05;
+const FRAME_DRILL = 0x06;
+const FRAME_TELEMETRY = 0x81;
+
+/** Wire width per config field: 1 = u8, 2 = s16, 3 = u16 (same table as the firmware). */
+const CONFIG_FIELD_WIDTH = [1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 2, 3, 2, 3, 2, 3, 1, 1, 3, 1, 1, 3, 3, 1, 1, 3];
+
+/** CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). */
+export function crc16Ccitt(bytes: number[]): number {
+  let crc = 0xffff;
+  for (const b of bytes) {
+    crc ^= (b & 0xff) << 8;
+    for (let i = 0; i < 8; i++) {
+      crc = crc & 0x8000 ? ((crc << 1) ^ 0x1021) & 0xffff : (crc << 1) & 0xffff;
+    }
+  }
+  return crc;
+}
+
+function pushU16(out: number[], v: number): void {
+  const x = Math.round(v) & 0xffff;
+  out.push(x & 0xff, x >> 8);
+}
+
+function pushField(out: number[], id: number, v: number): void {
+  if (CONFIG_FIELD_WIDTH[id] === 1) out.push(Math.max(0, Math.min(255, Math.round(v))));
+  else pushU16(out, v);
+}
+
+function buildFrame(type: number, payload: number[]): string {
+  const body = [BT_FRAME_VERSION, type, payload.length, ...payload];
+  const crc = crc16Ccitt(body);
+  const bytes = [BT_FRAME_SYNC, ...body, crc & 0xff, crc >> 8];
+  return String.fromCharCode(...bytes);
+}
+
+/** Binary config frame (54 bytes vs ~130 for the text line). */
+export function configToConfigFrame(config: RobotConfig): string {
+  const values = configToFields(config);
+  const payload: number[] = [];
+  values.forEach((v, i) => pushField(payload, i, v));
+  return buildFrame(FRAME_CONFIG, payload);
+}
+
+/** Binary delta frame: repeated { u8 id, value } (a one-field change is 9 bytes on the wire). */
+export function configDeltaFrame(delta: ConfigDelta): string {
+  const payload: number[] = [];
+  delta.forEach(([id, v]) => {
+    payload.push(id);
+    pushField(payload, id, v);
+  });
+  return buildFrame(FRAME_DELTA, payload);
+}
+
+// ---- Drill programs (firmware drill.h) ----
+
+export type DrillStepEnd = 'hold' | 'seconds' | 'balls';
+
+/**
+ * One drill step: config fields overridden on top of the run's config, for `amount` seconds or
+ * balls. 'hold' runs until stop or the timer; a program whose last step is not 'hold' stops the
+ * run when that step completes. Ball counts use the robot's exit sensor if fitted, else feeder
+ * pulses (which need a pulsed feeder mode).
+ */
+export type DrillStep = { end: DrillStepEnd; amount: number; fields: ConfigDelta };
+
+export const DRILL_MAX_STEPS = 8;
+export const DRILL_MAX_FIELDS = 8;
+const DRILL_END_CODES: Record<DrillStepEnd, number> = { hold: 0, seconds: 1, balls: 2 };
+
+/** Q,<step>,<end>,<amount>[,<id>,<value>...]\n with a 1-based step; steps go out in order. Reply OK,Q,<steps stored>. */
+export function drillStepLine(step: number, drill: DrillStep): string {
+  const head = `Q,${step},${DRILL_END_CODES[drill.end]},${Math.round(drill.amount)}`;
+  return head + drill.fields.map(([id, v]) => `,${id},${v}`).join('') + '\n';
+}
+
+export function getDrillClearCommand(): string {
+  return 'Q,0\n';
+}
+
+/** Step count from OK,Q,<n>, or null. ERR,Q,BUSY means a drill is running; stop first. */
+export function parseDrillAck(line: string): number | null {
+  if (!line.startsWith('OK,Q,')) return null;
+  const v = parseInt(line.slice(5), 10);
+  return Number.isNaN(v) ? null : v;
+}
+
+/** Binary drill step: u8 step, u8 end, u16 amount, then { u8 id, value } pairs as in a delta frame. */
+export function drillStepFrame(step: number, drill: DrillStep): string {
+  const payload: number[] = [step, DRILL_END_CODES[drill.end]];
+  pushU16(payload, drill.amount);
+  drill.fields.forEach(([id, v]) => {
+    payload.push(id);
+    pushField(payload, id, v);
+  });
+  return buildFrame(FRAME_DRILL, payload);
+}
+
+export function getDrillClearFrame(): string {
+  return buildFrame(FRAME_DRILL, [0]);
+}
+
+/** Binary live-aim frame. Values *1000. */
+export function getLiveAimFrame(pan: number, tilt: number): string {
+  const payload: number[] = [];
+  pushU16(payload, pan * 1000);
+  pushU16(payload, tilt * 1000);
+  return buildFrame(FRAME_AIM, payload);
+}
+
+/** App timestamps in aim samples are ms mod 32768 (same width as a text field on the robot). */
+export const AIM_STREAM_T_MASK = 0x7fff;
+
+/** Streamed aim sample: aim frame plus u16 app ms; the robot buffers and interpolates these. */
+export function getLiveAimSampleFrame(pan: number, tilt: number, appMs: number): string {
+  const payload: number[] = [];
+  pushU16(payload, pan * 1000);
+  pushU16(payload, tilt * 1000);
+  pushU16(payload, appMs & AIM_STREAM_T_MASK);
+  return buildFrame(FRAME_AIM, payload);
+}
+
+export type RobotFrame = { type: number; payload: number[]; length: number };
+
+/**
+ * Robot -> app frame starting at buf[start] (a SYNC byte). Returns 'incomplete' until all bytes are
+ * in, null when the header or CRC is bad (caller skips the SYNC byte and resyncs).
+ */
+export function parseRobotFrame(buf: string, start: number): RobotFrame | 'incomplete' | null {
+  if (buf.length - start < 4) return 'incomplete';
+  const ver = buf.charCodeAt(start + 1);
+  const len = buf.charCodeAt(start + 3);
+  if (ver === 0 || ver > BT_FRAME_VERSION || len > 64) return null;
+  const total = len + 6;
+  if (buf.length - start < total) return 'incomplete';
+  const body: number[] = [];
+  for (let i = start + 1; i < start + 4 + len; i++) body.push(buf.charCodeAt(i) & 0xff);
+  const crc = buf.charCodeAt(start + 4 + len) | (buf.charCodeAt(start + 5 + len) << 8);
+  if (crc16Ccitt(body) !== crc) return null;
+  return { type: body[1], payload: body.slice(3), length: total };
+}
+
+export const BT_FRAME_SYNC_CHAR = String.fromCharCode(BT_FRAME_SYNC);
+
+const FEEDER_PHASES: RobotTelemetry['feederPhase'][] = ['IDLE', 'PULLBACK', 'ON', 'OFF', 'UNJAM'];
+
+/** Decodes a telemetry frame (layout in firmware telemetry.h); null for other types or sizes. */
+export function parseTelemetryFrame(frame: RobotFrame): RobotTelemetry | null {
+  const p = frame.payload;
+  if (frame.type !== FRAME_TELEMETRY || p.length < 25) return null;
+  const u16 = (i: number) => p[i] | (p[i + 1] << 8);
+  const s16 = (i: number) => (u16(i) << 16) >> 16;
+  return {
+    seq: p[0],
+    running: (p[1] & 0x01) !== 0,
+    aimStreaming: (p[1] & 0x02) !== 0,
+    pan: s16(2) / 1000,
+    tilt: s16(4) / 1000,
+    launcherSpeeds: [s16(6), s16(8), s16(10)],
+    feederPhase: FEEDER_PHASES[p[12]] ?? 'IDLE',
+    loopP50Us: u16(13),
+    loopMaxUs: u16(15),
+    controlOverruns: u16(17),
+    elapsedMs: u16(19) + u16(21) * 65536,
+    shots: u16(23),
+    jams: p.length >= 27 ? u16(25) : 0,
+    wheelRpm: p.length >= 33 ? [u16(27), u16(29), u16(31)] : [0, 0, 0],
+    configRevision: p.length >= 35 ? u16(33) : null,
+  };
+}
+
+export function getStartFrame(): string {
+  return buildFrame(FRAME_START, []);
+}
+
+export function getStopFrame(): string {
+  return buildFrame(FRAME_STOP, []);
+}
@@ -18,7 +18,7 @@ const FEEDER_MIN_SPEED_TO_ROTATE = 60;
 const T_SEC_AT_70 = 4.5;
 const T_SEC_AT_160 = 2.91;
 const T_SEC_AT_255 = 2.6;
-const HOLES_PER_ROTATION = 3;
+export const HOLES_PER_ROTATION = 3;
 
 /** Segundos por volta completa do disco para um dado speed (0–255), assumindo 7,5 V. Exportado para preview de rotação. */
 export function secondsPerRotation(speed: number): number {
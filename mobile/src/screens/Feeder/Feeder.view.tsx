@@ -24,17 +24,22 @@ const VISUALIZER_SIZE = 160;
 const CUSTOM_STEP_MS = 250;
 const CUSTOM_MIN_MS = 500;
 const CUSTOM_MAX_MS = 5000;
+const BPM_MIN = 10;
+const BPM_MAX = 120;
+const BPM_STEP = 5;
 
 type FeederViewProps = {
   feederMode: FeederMode;
   feederSpeed: number;
   feederCustomOnMs: number;
   feederCustomOffMs: number;
+  feederBpm: number;
   feederModes: FeederMode[];
   onModeSelect: (mode: FeederMode) => void;
   onSpeedChange: (value: number) => void;
   onCustomOnMsChange: (value: number) => void;
   onCustomOffMsChange: (value: number) => void;
+  onBpmChange: (value: number) => void;
   onReset: () => void;
 };
 
@@ -43,18 +48,22 @@ export function FeederView({
   feederSpeed,
   feederCustomOnMs,
   feederCustomOffMs,
+  feederBpm,
   feederModes,
   onModeSelect,
   onSpeedChange,
   onCustomOnMsChange,
   onCustomOffMsChange,
+  onBpmChange,
   onReset,
 }: FeederViewProps) {
   const { t } = useTranslation();
   const { onMs: visOnMs, offMs: visOffMs } = getFeederOnOffMs(
     feederMode,
     feederCustomOnMs,
-    feederCustomOffMs
+    feederCustomOffMs,
+    feederBpm,
+    feederSpeed
   );
   const continuousBalls = estimateBallsPerMinute(feederSpeed);
   const displayBallsPerMin =
@@ -169,6 +178,25 @@ export function FeederView({
           />
         </View>
       )}
+      {feederMode === 'BPM' && (
+        <View style={styles.section}>
+          <View style={styles.sliderRow}>
+            <Text style={styles.label}>{t('feeder.bpm')}</Text>
+            <Text style={styles.value}>{feederBpm}</Text>
+          </View>
+          <Slider
+            style={styles.slider}
+            minimumValue={BPM_MIN}
+            maximumValue={BPM_MAX}
+            step={BPM_STEP}
+            value={feederBpm}
+            onValueChange={onBpmChange}
+            minimumTrackTintColor={theme.colors.primary}
+            maximumTrackTintColor={theme.colors.border}
+            thumbTintColor={theme.colors.primary}
+          />
+        </View>
+      )}
       <TouchableOpacity style={styles.resetButton} onPress={onReset} activeOpacity={0.85}>
         <MaterialCommunityIcons name="restore" size={20} color={theme.colors.text} />
         <Text style={styles.resetLabel}>{t('feeder.reset')}</Text>
@@ -13,6 +13,7 @@ export function getFeederState() {
     feederSpeed: c.feederSpeed,
     feederCustomOnMs: c.feederCustomOnMs,
     feederCustomOffMs: c.feederCustomOffMs,
+    feederBpm: c.feederBpm,
   };
 }
 
@@ -32,6 +33,10 @@ export function setFeederCustomOffMs(value: number) {
   RobotConfigRepository.setConfig({ feederCustomOffMs: value });
 }
 
+export function setFeederBpm(value: number) {
+  RobotConfigRepository.setConfig({ feederBpm: value });
+}
+
 export function subscribeConfig(cb: (c: import('../../data/RobotConfig').RobotConfig) => void) {
   return RobotConfigRepository.subscribe(cb);
 }
@@ -42,5 +47,6 @@ export function resetFeeder() {
     feederSpeed: DEFAULT_CONFIG.feederSpeed,
     feederCustomOnMs: DEFAULT_CONFIG.feederCustomOnMs,
     feederCustomOffMs: DEFAULT_CONFIG.feederCustomOffMs,
+    feederBpm: DEFAULT_CONFIG.feederBpm,
   });
 }
@@ -7,6 +7,7 @@ import {
   setFeederSpeed,
   setFeederCustomOnMs,
   setFeederCustomOffMs,
+  setFeederBpm,
   subscribeConfig,
 } from './Feeder.viewModel';
 import { FeederView } from './Feeder.view';
@@ -21,6 +22,7 @@ export function FeederScreen() {
         feederSpeed: c.feederSpeed,
         feederCustomOnMs: c.feederCustomOnMs,
         feederCustomOffMs: c.feederCustomOffMs,
+        feederBpm: c.feederBpm,
       });
     });
   }, []);
@@ -33,11 +35,13 @@ export function FeederScreen() {
       feederSpeed={state.feederSpeed}
       feederCustomOnMs={state.feederCustomOnMs}
       feederCustomOffMs={state.feederCustomOffMs}
+      feederBpm={state.feederBpm}
       feederModes={feederModes}
       onModeSelect={setFeederMode}
       onSpeedChange={setFeederSpeed}
       onCustomOnMsChange={setFeederCustomOnMs}
       onCustomOffMsChange={setFeederCustomOffMs}
+      onBpmChange={setFeederBpm}
       onReset={resetFeeder}
     />
   );
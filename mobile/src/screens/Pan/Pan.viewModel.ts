@@ -3,9 +3,6 @@ import { AXIS_MODES, DEFAULT_CONFIG } from '../../data/RobotConfig';
 import { RobotConfigRepository } from '../../data/RobotConfigRepository';
 import { RobotConnectionRepository } from '../../data/RobotConnectionRepository';
 
-const LIVE_SEND_DEBOUNCE_MS = 400;
-let panLiveSendTimeout: ReturnType<typeof setTimeout> | null = null;
-
 export function getAxisModes(): AxisMode[] {
   return AXIS_MODES;
 }
@@ -38,34 +35,20 @@ export function setPanMode(mode: AxisMode) {
   RobotConfigRepository.setConfig({ panMode: mode });
 }
 
+/** While dragging in LIVE mode the target is streamed (~40 Hz); the robot smooths the samples. */
 export function setPanTarget(value: number) {
   RobotConfigRepository.setConfig({ panTarget: value });
-  const c = RobotConfigRepository.getConfig();
-  if (c.panMode !== 'LIVE') {
-    if (panLiveSendTimeout !== null) {
-      clearTimeout(panLiveSendTimeout);
-      panLiveSendTimeout = null;
-    }
-    return;
-  }
-  if (panLiveSendTimeout !== null) clearTimeout(panLiveSendTimeout);
-  panLiveSendTimeout = setTimeout(() => {
-    panLiveSendTimeout = null;
-    sendLiveAimNow();
-  }, LIVE_SEND_DEBOUNCE_MS);
+  if (RobotConfigRepository.getConfig().panMode === 'LIVE') streamLiveAimNow();
 }
 
-function sendLiveAimNow() {
+function streamLiveAimNow() {
   const c = RobotConfigRepository.getConfig();
-  RobotConnectionRepository.sendLiveAim(c.panTarget, c.tiltTarget).catch(() => {});
+  RobotConnectionRepository.streamLiveAim(c.panTarget, c.tiltTarget);
 }
 
+/** End of a drag: make sure the final position is in the stream. */
 export function flushPanLiveSend() {
-  if (panLiveSendTimeout !== null) {
-    clearTimeout(panLiveSendTimeout);
-    panLiveSendTimeout = null;
-  }
-  sendLiveAimNow();
+  streamLiveAimNow();
 }
 
 export function setPanMin(value: number) {
@@ -172,12 +172,16 @@ export function RunningView({
               feederOnMs={getFeederOnOffMs(
                 runConfig.feederMode,
                 runConfig.feederCustomOnMs,
-                runConfig.feederCustomOffMs
+                runConfig.feederCustomOffMs,
+                runConfig.feederBpm,
+                runConfig.feederSpeed
               ).onMs}
               feederOffMs={getFeederOnOffMs(
                 runConfig.feederMode,
                 runConfig.feederCustomOnMs,
-                runConfig.feederCustomOffMs
+                runConfig.feederCustomOffMs,
+                runConfig.feederBpm,
+                runConfig.feederSpeed
               ).offMs}
               animate={true}
             />
@@ -3,9 +3,6 @@ import { AXIS_MODES, DEFAULT_CONFIG } from '../../data/RobotConfig';
 import { RobotConfigRepository } from '../../data/RobotConfigRepository';
 import { RobotConnectionRepository } from '../../data/RobotConnectionRepository';
 
-const LIVE_SEND_DEBOUNCE_MS = 400;
-let tiltLiveSendTimeout: ReturnType<typeof setTimeout> | null = null;
-
 export function getAxisModes(): AxisMode[] {
   return AXIS_MODES;
 }
@@ -38,34 +35,20 @@ export function setTiltMode(mode: AxisMode) {
   RobotConfigRepository.setConfig({ tiltMode: mode });
 }
 
+/** While dragging in LIVE mode the target is streamed (~40 Hz); the robot smooths the samples. */
 export function setTiltTarget(value: number) {
   RobotConfigRepository.setConfig({ tiltTarget: value });
-  const c = RobotConfigRepository.getConfig();
-  if (c.tiltMode !== 'LIVE') {
-    if (tiltLiveSendTimeout !== null) {
-      clearTimeout(tiltLiveSendTimeout);
-      tiltLiveSendTimeout = null;
-    }
-    return;
-  }
-  if (tiltLiveSendTimeout !== null) clearTimeout(tiltLiveSendTimeout);
-  tiltLiveSendTimeout = setTimeout(() => {
-    tiltLiveSendTimeout = null;
-    sendLiveAimNow();
-  }, LIVE_SEND_DEBOUNCE_MS);
+  if (RobotConfigRepository.getConfig().tiltMode === 'LIVE') streamLiveAimNow();
 }
 
-function sendLiveAimNow() {
+function streamLiveAimNow() {
   const c = RobotConfigRepository.getConfig();
-  RobotConnectionRepository.sendLiveAim(c.panTarget, c.tiltTarget).catch(() => {});
+  RobotConnectionRepository.streamLiveAim(c.panTarget, c.tiltTarget);
 }
 
+/** End of a drag: make sure the final position is in the stream. */
 export function flushTiltLiveSend() {
-  if (tiltLiveSendTimeout !== null) {
-    clearTimeout(tiltLiveSendTimeout);
-    tiltLiveSendTimeout = null;
-  }
-  sendLiveAimNow();
+  streamLiveAimNow();
 }
 
 export function setTiltMin(value: number) {
@@ -15,7 +15,10 @@ type TimerViewProps = {
   timerIndex: number;
   timerSoundAlert: boolean;
   options: readonly string[];
+  ballLimit: number;
+  ballLimitOptions: readonly number[];
   onSelect: (index: number) => void;
+  onBallLimitSelect: (value: number) => void;
   onTimerSoundAlertChange: (value: boolean) => void;
   onReset: () => void;
 };
@@ -24,7 +27,10 @@ export function TimerView({
   timerIndex,
   timerSoundAlert,
   options,
+  ballLimit,
+  ballLimitOptions,
   onSelect,
+  onBallLimitSelect,
   onTimerSoundAlertChange,
   onReset,
 }: TimerViewProps) {
@@ -50,6 +56,23 @@ export function TimerView({
           ))}
         </View>
       </View>
+      <View style={styles.section}>
+        <Text style={styles.label}>{t('timer.ballLimit')}</Text>
+        <View style={styles.chipRow}>
+          {ballLimitOptions.map((n) => (
+            <TouchableOpacity
+              key={n}
+              style={[styles.chip, ballLimit === n && styles.chipSelected]}
+              onPress={() => onBallLimitSelect(n)}
+              activeOpacity={0.8}
+            >
+              <Text style={[styles.chipText, ballLimit === n && styles.chipTextSelected]}>
+                {n === 0 ? 'OFF' : n}
+              </Text>
+            </TouchableOpacity>
+          ))}
+        </View>
+      </View>
       {timerEnabled && (
         <View style={styles.section}>
           <View style={styles.toggleRow}>
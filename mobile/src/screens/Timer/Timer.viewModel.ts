@@ -1,13 +1,17 @@
-import { DEFAULT_CONFIG, TIMER_OPTIONS } from '../../data/RobotConfig';
+import { BALL_LIMIT_OPTIONS, DEFAULT_CONFIG, TIMER_OPTIONS } from '../../data/RobotConfig';
 import { RobotConfigRepository } from '../../data/RobotConfigRepository';
 
 export function getTimerOptions(): readonly string[] {
   return TIMER_OPTIONS;
 }
 
+export function getBallLimitOptions(): readonly number[] {
+  return BALL_LIMIT_OPTIONS;
+}
+
 export function getTimerState() {
   const c = RobotConfigRepository.getConfig();
-  return { timerIndex: c.timerIndex, timerSoundAlert: c.timerSoundAlert };
+  return { timerIndex: c.timerIndex, timerSoundAlert: c.timerSoundAlert, ballLimit: c.ballLimit };
 }
 
 export function setTimerIndex(value: number) {
@@ -18,6 +22,10 @@ export function setTimerSoundAlert(value: boolean) {
   RobotConfigRepository.setConfig({ timerSoundAlert: value });
 }
 
+export function setBallLimit(value: number) {
+  RobotConfigRepository.setConfig({ ballLimit: value });
+}
+
 export function subscribeConfig(cb: (c: import('../../data/RobotConfig').RobotConfig) => void) {
   return RobotConfigRepository.subscribe(cb);
 }
@@ -26,5 +34,6 @@ export function resetTimer() {
   RobotConfigRepository.setConfig({
     timerIndex: DEFAULT_CONFIG.timerIndex,
     timerSoundAlert: DEFAULT_CONFIG.timerSoundAlert,
+    ballLimit: DEFAULT_CONFIG.ballLimit,
   });
 }
@@ -1,8 +1,10 @@
 import React, { useState, useEffect, useCallback } from 'react';
 import {
+  getBallLimitOptions,
   getTimerOptions,
   getTimerState,
   resetTimer,
+  setBallLimit,
   setTimerIndex,
   setTimerSoundAlert,
   subscribeConfig,
@@ -15,7 +17,11 @@ export function TimerScreen() {
 
   useEffect(() => {
     return subscribeConfig((c) => {
-      setState({ timerIndex: c.timerIndex, timerSoundAlert: c.timerSoundAlert });
+      setState({
+        timerIndex: c.timerIndex,
+        timerSoundAlert: c.timerSoundAlert,
+        ballLimit: c.ballLimit,
+      });
     });
   }, []);
 
@@ -27,13 +33,17 @@ export function TimerScreen() {
   }, []);
 
   const options = getTimerOptions();
+  const ballLimitOptions = getBallLimitOptions();
 
   return (
     <TimerView
       timerIndex={state.timerIndex}
       timerSoundAlert={state.timerSoundAlert}
       options={options}
+      ballLimit={state.ballLimit}
+      ballLimitOptions={ballLimitOptions}
       onSelect={setTimerIndex}
+      onBallLimitSelect={setBallLimit}
       onTimerSoundAlertChange={handleTimerSoundAlertChange}
       onReset={resetTimer}
     />
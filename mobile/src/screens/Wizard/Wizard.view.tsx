@@ -92,12 +92,16 @@ export function WizardView({ items, config, displaySpin, connectionStatus, willT
                 feederOnMs={getFeederOnOffMs(
                   config.feederMode,
                   config.feederCustomOnMs,
-                  config.feederCustomOffMs
+                  config.feederCustomOffMs,
+                  config.feederBpm,
+                  config.feederSpeed
                 ).onMs}
                 feederOffMs={getFeederOnOffMs(
                   config.feederMode,
                   config.feederCustomOnMs,
-                  config.feederCustomOffMs
+                  config.feederCustomOffMs,
+                  config.feederBpm,
+                  config.feederSpeed
                 ).offMs}
                 animate={true}
               />
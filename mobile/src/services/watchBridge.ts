@@ -85,8 +85,10 @@ function applyWatchConfig(key: string, value: string): Partial<RobotConfig> {
     feederSpeed: num,
     feederCustomOnMs: num,
     feederCustomOffMs: num,
+    feederBpm: num,
     timerIndex: num,
     timerSoundAlert: bool,
+    ballLimit: num,
   };
   const fn = map[key as keyof typeof map];
   if (!fn) return {};